@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+struct bench_t {
+	const char *name;
+	void (*run)(void);
+};
+
+// Benchmarks report each measurement they make through this, so results
+// are all collected and printed in the same format.
+void   bench_report(const char *bench, const char *measure, int32_t item_count, double ms);
+double bench_now_ms();
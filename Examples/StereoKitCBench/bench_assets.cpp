@@ -0,0 +1,131 @@
+#include "bench_assets.h"
+#include "bench.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#define ARRAY_MALLOC  ::malloc
+#define ARRAY_FREE    ::free
+#define ARRAY_REALLOC ::realloc
+#include <asset_types/assets_index.h>
+#include <libraries/ferr_hash.h>
+
+using namespace sk;
+
+///////////////////////////////////////////
+
+// Loads a model the way the glTF loader does: every mesh and material
+// checks whether it already exists by id before creating itself, with
+// materials shared between meshes. Then the model gets unloaded again. The
+// id lookups are done with a scan over every asset, which is how
+// assets_find used to work, and with the (id, type) index.
+
+const int32_t bench_assets_counts[]   = { 1000, 5000, 20000 };
+const int32_t bench_assets_iterations = 3;
+
+struct bench_assets_t {
+	array_t<asset_header_t *> list;
+	asset_index_t             index;
+	bool                      indexed;
+};
+
+///////////////////////////////////////////
+
+asset_header_t *bench_assets_find(bench_assets_t *assets, uint64_t id, asset_type_ type) {
+	if (assets->indexed)
+		return asset_index_find(&assets->index, id, type);
+
+	for (int32_t i = 0; i < assets->list.count; i++) {
+		if (assets->list[i]->id == id && assets->list[i]->type == type && assets->list[i]->refs > 0)
+			return assets->list[i];
+	}
+	return nullptr;
+}
+
+///////////////////////////////////////////
+
+// Allocating, and then giving it a proper name, same as assets_allocate and
+// assets_set_id.
+asset_header_t *bench_assets_create(bench_assets_t *assets, asset_type_ type, const char *name) {
+	char auto_name[64];
+	snprintf(auto_name, sizeof(auto_name), "auto/asset_%d", assets->list.count);
+
+	asset_header_t *asset = (asset_header_t *)calloc(1, sizeof(asset_header_t));
+	asset->type = type;
+	asset->id   = hash_fnv64_string(auto_name);
+	asset->refs = 1;
+	assets->list.add(asset);
+	if (assets->indexed) asset_index_add(&assets->index, asset);
+
+	// Now assets_set_id
+	if (assets->indexed) asset_index_remove(&assets->index, asset);
+	asset->id = hash_fnv64_string(name);
+	if (assets->indexed) asset_index_add(&assets->index, asset);
+	return asset;
+}
+
+///////////////////////////////////////////
+
+void bench_assets_destroy(bench_assets_t *assets, asset_header_t *asset) {
+	if (assets->indexed) asset_index_remove(&assets->index, asset);
+	for (int32_t i = assets->list.count - 1; i >= 0; i--) {
+		if (assets->list[i] == asset) {
+			assets->list.remove(i);
+			break;
+		}
+	}
+	free(asset);
+}
+
+///////////////////////////////////////////
+
+double bench_assets_load(int32_t mesh_count, bool indexed) {
+	double best = 1e10;
+	for (int32_t it = 0; it < bench_assets_iterations; it++) {
+		bench_assets_t assets = {};
+		assets.indexed = indexed;
+
+		// A few built-in assets, like the ones StereoKit starts with
+		char name[64];
+		for (int32_t i = 0; i < 64; i++) {
+			snprintf(name, sizeof(name), "default/asset_%d", i);
+			bench_assets_create(&assets, (asset_type_)(i % 4), name);
+		}
+		int32_t base_count = assets.list.count;
+
+		double start = bench_now_ms();
+		for (int32_t i = 0; i < mesh_count; i++) {
+			snprintf(name, sizeof(name), "model.glb/material/%d", i / 4);
+			if (bench_assets_find(&assets, hash_fnv64_string(name), asset_type_material) == nullptr)
+				bench_assets_create(&assets, asset_type_material, name);
+
+			snprintf(name, sizeof(name), "model.glb/mesh/%d", i);
+			if (bench_assets_find(&assets, hash_fnv64_string(name), asset_type_mesh) == nullptr)
+				bench_assets_create(&assets, asset_type_mesh, name);
+		}
+		int32_t loaded = assets.list.count - base_count;
+		while (assets.list.count > base_count)
+			bench_assets_destroy(&assets, assets.list.last());
+		double time = bench_now_ms() - start;
+
+		bool valid = loaded == mesh_count + (mesh_count + 3) / 4 && (!indexed || assets.index.count == base_count);
+		while (assets.list.count > 0)
+			bench_assets_destroy(&assets, assets.list.last());
+		assets.list .free();
+		assets.index.free();
+
+		if (!valid) { best = -1; break; }
+		if (time < best) best = time;
+	}
+	return best;
+}
+
+///////////////////////////////////////////
+
+void bench_assets_run() {
+	for (int32_t c = 0; c < (int32_t)(sizeof(bench_assets_counts)/sizeof(bench_assets_counts[0])); c++) {
+		int32_t count = bench_assets_counts[c];
+		bench_report("assets_find", "linear_scan", count, bench_assets_load(count, false));
+		bench_report("assets_find", "id_index",    count, bench_assets_load(count, true ));
+	}
+}
@@ -0,0 +1,163 @@
+#include "bench_occlusion.h"
+#include "bench.h"
+
+#include <systems/render_occlusion.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+using namespace sk;
+using namespace DirectX;
+
+///////////////////////////////////////////
+
+// Rasterizes a wall into the occlusion buffer and tests a field of boxes
+// against it, the same way the renderer does before batching. Boxes the
+// buffer culls are checked against the real geometry, since culling
+// something that's even partly visible would be a visible bug. The second
+// wall size puts its edges past pixel centers, which leaves pixels that
+// are only partly covered, but would pass a pixel center test.
+
+const int32_t bench_occlusion_counts[]   = { 1000, 10000, 100000 };
+const int32_t bench_occlusion_iterations = 20;
+const int32_t bench_occlusion_width      = 256;
+const int32_t bench_occlusion_height     = 128;
+const float   bench_wall_z               = -5;
+const float   bench_wall_halves[]        = { 4, 3.9f };
+const char   *bench_wall_names []        = { "", "_unaligned" };
+const int32_t bench_edge_boxes           = 256;
+
+struct bench_box_t {
+	XMVECTOR center;
+	XMVECTOR extents;
+};
+
+///////////////////////////////////////////
+
+float bench_rand(uint32_t *seed, float min, float max) {
+	*seed = *seed * 1664525 + 1013904223;
+	return min + ((*seed >> 8) / (float)(1 << 24)) * (max - min);
+}
+
+///////////////////////////////////////////
+
+// The viewer is at the origin, so a point is hidden if it's past the wall
+// and the line to it passes through the wall. The wall and boxes are both
+// convex, so a box is hidden if all its corners are.
+bool bench_box_hidden(const bench_box_t *box, float wall_half) {
+	for (int32_t i = 0; i < 8; i++) {
+		XMVECTOR sign   = XMVectorSet(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 0);
+		XMFLOAT3 corner;
+		XMStoreFloat3(&corner, XMVectorMultiplyAdd(box->extents, sign, box->center));
+		if (corner.z >= bench_wall_z) return false;
+
+		float t = bench_wall_z / corner.z;
+		if (fabsf(corner.x * t) > wall_half || fabsf(corner.y * t) > wall_half) return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////
+
+// Thin boxes that sit just behind the wall and poke out past its
+// silhouette by a small fraction of a pixel, right where the wall only
+// partly covers the pixels along its edges.
+void bench_edge_box(bench_box_t *box, uint32_t *seed, int32_t side, float wall_half) {
+	float z      = bench_rand(seed, -20, -6);
+	float extent = bench_rand(seed, 0.2f, 0.5f);
+	float edge   = wall_half * (z + 0.01f) / bench_wall_z;
+	float along  = bench_rand(seed, -0.8f, 0.8f) * edge;
+	float across = (edge - extent + 0.001f * -z) * (side & 1 ? -1 : 1);
+	box->center  = side < 2
+		? XMVectorSet(across, along, z, 0)
+		: XMVectorSet(along, across, z, 0);
+	box->extents = XMVectorSet(extent, extent, 0.01f, 0);
+}
+
+///////////////////////////////////////////
+
+void bench_occlusion_wall(const char *name, float wall_half) {
+	XMFLOAT3 wall_verts[] = {
+		{-wall_half, -wall_half, bench_wall_z},
+		{ wall_half, -wall_half, bench_wall_z},
+		{ wall_half,  wall_half, bench_wall_z},
+		{-wall_half,  wall_half, bench_wall_z}, };
+	uint32_t wall_inds[] = { 0,1,2, 0,2,3 };
+
+	XMMATRIX view     = XMMatrixLookAtRH(XMVectorZero(), XMVectorSet(0, 0, -1, 0), XMVectorSet(0, 1, 0, 0));
+	XMMATRIX proj     = XMMatrixPerspectiveFovRH(XMConvertToRadians(90), 2.0f, 0.02f, 50);
+	XMMATRIX viewproj = view * proj;
+	float   *depth    = (float*)malloc(sizeof(float) * bench_occlusion_width * bench_occlusion_height);
+	char     measure[64];
+
+	occlusion_buffer_t buffer = {};
+	double raster_best = 1e10;
+	for (int32_t i = 0; i < bench_occlusion_iterations; i++) {
+		double start = bench_now_ms();
+		occlusion_begin    (&buffer, depth, bench_occlusion_width, bench_occlusion_height, viewproj);
+		occlusion_rasterize(&buffer, wall_verts, sizeof(XMFLOAT3), 4, wall_inds, 6, XMMatrixIdentity());
+		double time = bench_now_ms() - start;
+		if (time < raster_best) raster_best = time;
+	}
+	snprintf(measure, sizeof(measure), "rasterize%s", name);
+	bench_report("render_occlusion", measure, buffer.triangles, raster_best);
+
+	for (int32_t c = 0; c < (int32_t)(sizeof(bench_occlusion_counts)/sizeof(bench_occlusion_counts[0])); c++) {
+		int32_t      count = bench_occlusion_counts[c];
+		bench_box_t *boxes  = (bench_box_t*)malloc(sizeof(bench_box_t) * count);
+		bool        *culled = (bool*)malloc(sizeof(bool) * count);
+		uint32_t     seed   = 1;
+		for (int32_t i = 0; i < count; i++) {
+			if (i < bench_edge_boxes) {
+				bench_edge_box(&boxes[i], &seed, i % 4, wall_half);
+				continue;
+			}
+			float z = bench_rand(&seed, -30, -2);
+			boxes[i].center  = XMVectorSet(bench_rand(&seed, z, -z), bench_rand(&seed, z*0.5f, -z*0.5f), z, 0);
+			boxes[i].extents = XMVectorReplicate(bench_rand(&seed, 0.1f, 1.0f));
+		}
+
+		double  best         = 1e10;
+		int32_t culled_count = 0;
+		for (int32_t i = 0; i < bench_occlusion_iterations; i++) {
+			culled_count = 0;
+			double start = bench_now_ms();
+			for (int32_t b = 0; b < count; b++) {
+				culled[b] = !occlusion_visible(&buffer, boxes[b].center, boxes[b].extents);
+				culled_count += culled[b] ? 1 : 0;
+			}
+			double time = bench_now_ms() - start;
+			if (time < best) best = time;
+		}
+
+		// Nothing visible may be culled, and a wall filling a good part of
+		// the view should hide something.
+		int32_t hidden_count = 0;
+		bool    valid        = culled_count > 0;
+		for (int32_t b = 0; b < count; b++) {
+			bool hidden = bench_box_hidden(&boxes[b], wall_half);
+			if (hidden)               hidden_count++;
+			if (culled[b] && !hidden) valid = false;
+		}
+
+		// The culled and hidden counts are reported as item counts, so it's
+		// easy to see how close the buffer gets to the real answer.
+		snprintf(measure, sizeof(measure), "test%s", name);
+		bench_report("render_occlusion", measure, count,        valid ? best : -1);
+		snprintf(measure, sizeof(measure), "culled%s", name);
+		bench_report("render_occlusion", measure, culled_count, valid ? best : -1);
+		snprintf(measure, sizeof(measure), "hidden%s", name);
+		bench_report("render_occlusion", measure, hidden_count, 0);
+		free(boxes);
+		free(culled);
+	}
+	free(depth);
+}
+
+///////////////////////////////////////////
+
+void bench_occlusion_run() {
+	for (int32_t w = 0; w < (int32_t)(sizeof(bench_wall_halves)/sizeof(bench_wall_halves[0])); w++)
+		bench_occlusion_wall(bench_wall_names[w], bench_wall_halves[w]);
+}
@@ -0,0 +1,251 @@
+#include "bench_sort.h"
+#include "bench.h"
+
+#include <systems/render_sort.h>
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+using namespace sk;
+
+///////////////////////////////////////////
+
+// Compares sorting the render queue by moving whole render items around,
+// which is how the queue used to be sorted, against sorting small
+// key/index pairs and then gathering the items through the index.
+
+// Same size and layout as a render item that carries its own transform,
+// bounds and color.
+struct alignas(16) bench_payload_t {
+	float    transform[16];
+	float    bounds_center[4];
+	float    bounds_extents[4];
+	float    color[4];
+	uint64_t sort_id;
+	void    *mesh;
+	void    *material;
+	int32_t  mesh_inds;
+	int32_t  inst_start;
+	int32_t  inst_count;
+	uint16_t layer;
+};
+
+struct bench_key_t {
+	uint64_t sort_id;
+	uint32_t index;
+};
+
+const int32_t bench_sort_counts[] = { 1000, 10000, 50000, 100000 };
+const int32_t bench_sort_iterations = 20;
+
+///////////////////////////////////////////
+
+// A small persistent pool in the same shape as the renderer's sort pool, so
+// the multi-threaded measurement doesn't include creating threads.
+struct bench_pool_t {
+	std::mutex               mtx;
+	std::condition_variable  work_ready;
+	std::condition_variable  work_done;
+	std::thread             *threads;
+	int32_t                  thread_count;
+	bool                     quit;
+	radix_job_fn             job;
+	void                    *job_ctx;
+	int32_t                  job_count;
+	int32_t                  job_next;
+	int32_t                  job_finished;
+};
+static bench_pool_t bench_pool;
+
+void bench_pool_thread() {
+	std::unique_lock<std::mutex> lock(bench_pool.mtx);
+	while (!bench_pool.quit) {
+		if (bench_pool.job_next >= bench_pool.job_count) {
+			bench_pool.work_ready.wait(lock);
+			continue;
+		}
+		int32_t job_idx = bench_pool.job_next++;
+		lock.unlock();
+		bench_pool.job(bench_pool.job_ctx, job_idx);
+		lock.lock();
+		if (++bench_pool.job_finished == bench_pool.job_count)
+			bench_pool.work_done.notify_one();
+	}
+}
+
+void bench_pool_dispatch(radix_job_fn job, void *job_ctx, int32_t job_count) {
+	std::unique_lock<std::mutex> lock(bench_pool.mtx);
+	bench_pool.job          = job;
+	bench_pool.job_ctx      = job_ctx;
+	bench_pool.job_count    = job_count;
+	bench_pool.job_next     = 0;
+	bench_pool.job_finished = 0;
+	bench_pool.work_ready.notify_all();
+
+	while (bench_pool.job_next < bench_pool.job_count) {
+		int32_t job_idx = bench_pool.job_next++;
+		lock.unlock();
+		job(job_ctx, job_idx);
+		lock.lock();
+		bench_pool.job_finished++;
+	}
+	bench_pool.work_done.wait(lock, []{ return bench_pool.job_finished >= bench_pool.job_count; });
+	bench_pool.job_count = 0;
+	bench_pool.job_next  = 0;
+}
+
+void bench_pool_start() {
+	int32_t cores = (int32_t)std::thread::hardware_concurrency();
+	bench_pool.thread_count = cores - 1;
+	if (bench_pool.thread_count > RADIX_MT_MAX_JOBS - 1) bench_pool.thread_count = RADIX_MT_MAX_JOBS - 1;
+	if (bench_pool.thread_count < 0)                     bench_pool.thread_count = 0;
+	bench_pool.threads = new std::thread[bench_pool.thread_count];
+	for (int32_t i = 0; i < bench_pool.thread_count; i++)
+		bench_pool.threads[i] = std::thread(bench_pool_thread);
+}
+
+void bench_pool_stop() {
+	{
+		std::lock_guard<std::mutex> lock(bench_pool.mtx);
+		bench_pool.quit = true;
+	}
+	bench_pool.work_ready.notify_all();
+	for (int32_t i = 0; i < bench_pool.thread_count; i++)
+		bench_pool.threads[i].join();
+	delete [] bench_pool.threads;
+	bench_pool.threads      = nullptr;
+	bench_pool.thread_count = 0;
+	bench_pool.quit         = false;
+}
+
+///////////////////////////////////////////
+
+uint64_t bench_sort_id(uint32_t *seed) {
+	// Roughly what real sort ids look like: a handful of queues, a few
+	// dozen materials, a few hundred meshes, and a random depth.
+	*seed = *seed * 1664525 + 1013904223; uint64_t queue    = 1000 + ((*seed >> 16) % 3) * 1000;
+	*seed = *seed * 1664525 + 1013904223; uint64_t material = (*seed >> 16) % 64;
+	*seed = *seed * 1664525 + 1013904223; uint64_t mesh     = (*seed >> 16) % 256;
+	*seed = *seed * 1664525 + 1013904223; uint64_t depth    = (*seed >> 16) & 0xFFFF;
+	return (queue << 48) | (material << 32) | (mesh << 16) | depth;
+}
+
+///////////////////////////////////////////
+
+double bench_sort_payload(const bench_payload_t *src, int32_t count) {
+	bench_payload_t *items   = (bench_payload_t*)malloc(sizeof(bench_payload_t) * count);
+	bench_payload_t *scratch = (bench_payload_t*)malloc(sizeof(bench_payload_t) * count);
+
+	double best = 1e10;
+	for (int32_t i = 0; i < bench_sort_iterations; i++) {
+		memcpy(items, src, sizeof(bench_payload_t) * count);
+
+		double start = bench_now_ms();
+		radix_sort7(items, scratch, count);
+
+		// Walking the sorted items, the same as render_list_execute
+		int64_t checksum = 0;
+		for (int32_t t = 0; t < count; t++) checksum += items[t].inst_start;
+		double time = bench_now_ms() - start;
+
+		if (checksum != (int64_t)count * (count - 1) / 2) { best = -1; break; }
+		if (time < best) best = time;
+	}
+
+	free(items);
+	free(scratch);
+	return best;
+}
+
+///////////////////////////////////////////
+
+double bench_sort_keys(const bench_payload_t *src, int32_t count) {
+	bench_key_t *keys    = (bench_key_t*)malloc(sizeof(bench_key_t) * count);
+	bench_key_t *scratch = (bench_key_t*)malloc(sizeof(bench_key_t) * count);
+
+	double best = 1e10;
+	for (int32_t i = 0; i < bench_sort_iterations; i++) {
+		double start = bench_now_ms();
+		for (int32_t t = 0; t < count; t++) keys[t] = { src[t].sort_id, (uint32_t)t };
+		radix_sort7(keys, scratch, count);
+
+		// Gathering the items through the sorted index
+		int64_t checksum = 0;
+		for (int32_t t = 0; t < count; t++) checksum += src[keys[t].index].inst_start;
+		double time = bench_now_ms() - start;
+
+		if (checksum != (int64_t)count * (count - 1) / 2) { best = -1; break; }
+		if (time < best) best = time;
+	}
+
+	free(keys);
+	free(scratch);
+	return best;
+}
+
+///////////////////////////////////////////
+
+double bench_sort_keys_mt(const bench_payload_t *src, int32_t count) {
+	bench_key_t     *keys    = (bench_key_t*)malloc(sizeof(bench_key_t) * count);
+	bench_key_t     *scratch = (bench_key_t*)malloc(sizeof(bench_key_t) * count);
+	radix_mt_work_t *work    = (radix_mt_work_t*)malloc(sizeof(radix_mt_work_t));
+
+	// Same job sizing as render_sort_keys
+	int32_t jobs = bench_pool.thread_count + 1;
+	if (jobs > count / 8192) jobs = count / 8192;
+
+	double best = 1e10;
+	for (int32_t i = 0; i < bench_sort_iterations; i++) {
+		double start = bench_now_ms();
+		for (int32_t t = 0; t < count; t++) keys[t] = { src[t].sort_id, (uint32_t)t };
+		radix_sort7_mt(keys, scratch, count, work, jobs, bench_pool_dispatch);
+		double time = bench_now_ms() - start;
+
+		// The result has to match the single threaded sort exactly, ties
+		// included, or draw order would change with thread count.
+		bool     valid    = true;
+		uint64_t prev_id  = 0;
+		uint32_t prev_idx = 0;
+		for (int32_t t = 0; t < count; t++) {
+			if (src[keys[t].index].sort_id != keys[t].sort_id) valid = false;
+			if (t > 0 && (keys[t].sort_id < prev_id || (keys[t].sort_id == prev_id && keys[t].index < prev_idx))) valid = false;
+			prev_id  = keys[t].sort_id;
+			prev_idx = keys[t].index;
+		}
+		if (!valid) { best = -1; break; }
+		if (time < best) best = time;
+	}
+
+	free(keys);
+	free(scratch);
+	free(work);
+	return best;
+}
+
+///////////////////////////////////////////
+
+void bench_sort_run() {
+	bench_pool_start();
+
+	for (int32_t c = 0; c < (int32_t)(sizeof(bench_sort_counts)/sizeof(bench_sort_counts[0])); c++) {
+		int32_t          count = bench_sort_counts[c];
+		bench_payload_t *src   = (bench_payload_t*)malloc(sizeof(bench_payload_t) * count);
+		uint32_t         seed  = 1;
+		memset(src, 0, sizeof(bench_payload_t) * count);
+		for (int32_t i = 0; i < count; i++) {
+			src[i].sort_id    = bench_sort_id(&seed);
+			src[i].inst_start = i;
+		}
+
+		bench_report("render_sort", "payload_sort", count, bench_sort_payload(src, count));
+		bench_report("render_sort", "key_index_sort", count, bench_sort_keys(src, count));
+		bench_report("render_sort", "key_index_sort_mt", count, bench_sort_keys_mt(src, count));
+		free(src);
+	}
+	bench_pool_stop();
+}
@@ -0,0 +1,43 @@
+#include "bench.h"
+#include "bench_sort.h"
+#include "bench_occlusion.h"
+#include "bench_assets.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+
+///////////////////////////////////////////
+
+bench_t benches[] = {
+	{ "render_sort",      bench_sort_run      },
+	{ "render_occlusion", bench_occlusion_run },
+	{ "assets_find",      bench_assets_run    },
+};
+
+///////////////////////////////////////////
+
+double bench_now_ms() {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///////////////////////////////////////////
+
+void bench_report(const char *bench, const char *measure, int32_t item_count, double ms) {
+	printf("%-16s %-24s %8d items %10.3f ms\n", bench, measure, item_count, ms);
+}
+
+///////////////////////////////////////////
+
+int main(int argc, char **argv) {
+	// Run everything by default, or just the benchmarks named on the
+	// command line.
+	for (int32_t i = 0; i < (int32_t)(sizeof(benches)/sizeof(benches[0])); i++) {
+		bool run = argc <= 1;
+		for (int32_t a = 1; a < argc; a++) {
+			if (strcmp(argv[a], benches[i].name) == 0) run = true;
+		}
+		if (run) benches[i].run();
+	}
+	return 0;
+}
@@ -0,0 +1,223 @@
+#include <stereokit.h>
+using namespace sk;
+
+#include "perf_scenes.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+///////////////////////////////////////////
+
+// Runs StereoKit without a display, draws a handful of scripted scenes
+// into an offscreen render target for a fixed number of frames, and writes
+// frame time percentiles, per-system timings and render stats to JSON.
+// With no GPU around, Mesa's llvmpipe works fine for this, e.g:
+//   LIBGL_ALWAYS_SOFTWARE=1 xvfb-run ./StereoKitCPerf --out perf.json
+
+perf_scene_t scenes[] = {
+	{ "meshes",        perf_meshes_init,        perf_meshes_update,        perf_meshes_shutdown        },
+	{ "models",        perf_models_init,        perf_models_update,        perf_models_shutdown        },
+	{ "ui",            perf_ui_init,            perf_ui_update,            perf_ui_shutdown            },
+	{ "lines_sprites", perf_lines_sprites_init, perf_lines_sprites_update, perf_lines_sprites_shutdown },
+};
+
+struct perf_args_t {
+	int32_t     frames;
+	int32_t     warmup;
+	int32_t     size;
+	int32_t     width;
+	int32_t     height;
+	const char *scene;
+	const char *out;
+};
+
+struct perf_result_t {
+	const char            *name;
+	int32_t                frames;
+	double                 frame_ms_avg;
+	double                 frame_ms_p50;
+	double                 frame_ms_p90;
+	double                 frame_ms_p99;
+	double                 frame_ms_max;
+	std::vector<double>    system_ms;
+	double                 stats[9];
+	double                 gpu_ms;
+	int32_t                gpu_frames;
+};
+
+const char *perf_stat_names[9] = { "draw_calls", "draw_instances", "swaps_mesh", "swaps_material", "swaps_texture", "culled", "occluded", "instance_ring_size", "instance_ring_stalls" };
+
+static perf_scene_t *perf_scene;
+static int32_t       perf_frame;
+static tex_t         perf_target;
+static matrix        perf_projection;
+
+///////////////////////////////////////////
+
+void perf_step() {
+	render_to(perf_target, matrix_identity, perf_projection);
+	perf_scene->update(perf_frame);
+	perf_frame++;
+}
+
+///////////////////////////////////////////
+
+double perf_percentile(const std::vector<double> &sorted, double percent) {
+	if (sorted.empty()) return 0;
+	size_t idx = (size_t)(percent * sorted.size());
+	return sorted[idx < sorted.size() ? idx : sorted.size() - 1];
+}
+
+///////////////////////////////////////////
+
+perf_result_t perf_run(perf_scene_t *scene, const perf_args_t *args) {
+	perf_result_t result = {};
+	result.name = scene->name;
+
+	perf_scene = scene;
+	perf_frame = 0;
+	scene->init(args->size);
+	for (int32_t i = 0; i < args->warmup; i++)
+		sk_step(perf_step);
+
+	int32_t system_count = sk_profile_system_count();
+	std::vector<double> system_start(system_count);
+	for (int32_t s = 0; s < system_count; s++)
+		system_start[s] = sk_profile_system_total_ms(s);
+
+	std::vector<double> frame_ms;
+	frame_ms.reserve(args->frames);
+	uint64_t gpu_frame = render_stats_gpu_frame();
+	for (int32_t i = 0; i < args->frames; i++) {
+		auto start = std::chrono::steady_clock::now();
+		if (!sk_step(perf_step)) break;
+		frame_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+
+		// Stats are from the frame that just finished, GPU timings show up
+		// a few frames late, so only count each GPU frame once.
+		render_frame_stats_t stats = render_stats_frame();
+		int32_t values[9] = { stats.draw_calls, stats.draw_instances, stats.swaps_mesh, stats.swaps_material, stats.swaps_texture, stats.culled, stats.occluded, stats.instance_ring_size, stats.instance_ring_stalls };
+		for (int32_t v = 0; v < 9; v++) result.stats[v] += values[v];
+		if (render_stats_gpu_frame() != gpu_frame) {
+			gpu_frame = render_stats_gpu_frame();
+			result.gpu_ms += render_stats_gpu_total_ms();
+			result.gpu_frames++;
+		}
+	}
+	scene->shutdown();
+
+	result.frames = (int32_t)frame_ms.size();
+	if (result.frames == 0) return result;
+
+	result.system_ms.resize(system_count);
+	for (int32_t s = 0; s < system_count; s++)
+		result.system_ms[s] = (sk_profile_system_total_ms(s) - system_start[s]) / result.frames;
+	for (int32_t v = 0; v < 9; v++)
+		result.stats[v] /= result.frames;
+	if (result.gpu_frames > 0)
+		result.gpu_ms /= result.gpu_frames;
+
+	double total = 0;
+	for (size_t i = 0; i < frame_ms.size(); i++) total += frame_ms[i];
+	std::sort(frame_ms.begin(), frame_ms.end());
+	result.frame_ms_avg = total / frame_ms.size();
+	result.frame_ms_p50 = perf_percentile(frame_ms, 0.50);
+	result.frame_ms_p90 = perf_percentile(frame_ms, 0.90);
+	result.frame_ms_p99 = perf_percentile(frame_ms, 0.99);
+	result.frame_ms_max = frame_ms.back();
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool perf_write_json(const char *filename, const perf_args_t *args, const std::vector<perf_result_t> &results) {
+	FILE *fp = fopen(filename, "w");
+	if (fp == nullptr) return false;
+
+	system_info_t info = sk_system_info();
+	fprintf(fp, "{\n");
+	fprintf(fp, "\t\"version\": \"%s\",\n", sk_version_name());
+	fprintf(fp, "\t\"display\": \"%s\",\n", info.display_type == display_none ? "none" : "flatscreen");
+	fprintf(fp, "\t\"width\": %d,\n\t\"height\": %d,\n\t\"size\": %d,\n", args->width, args->height, args->size);
+	fprintf(fp, "\t\"gpu_timing\": %s,\n", render_stats_gpu_available() ? "true" : "false");
+	fprintf(fp, "\t\"scenes\": [\n");
+	for (size_t r = 0; r < results.size(); r++) {
+		const perf_result_t *result = &results[r];
+		fprintf(fp, "\t\t{\n");
+		fprintf(fp, "\t\t\t\"name\": \"%s\",\n", result->name);
+		fprintf(fp, "\t\t\t\"frames\": %d,\n", result->frames);
+		fprintf(fp, "\t\t\t\"frame_ms\": { \"avg\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f },\n",
+			result->frame_ms_avg, result->frame_ms_p50, result->frame_ms_p90, result->frame_ms_p99, result->frame_ms_max);
+		fprintf(fp, "\t\t\t\"gpu_ms\": %.4f,\n", result->gpu_ms);
+
+		fprintf(fp, "\t\t\t\"system_ms\": {");
+		for (size_t s = 0; s < result->system_ms.size(); s++)
+			fprintf(fp, "%s\n\t\t\t\t\"%s\": %.4f", s == 0 ? "" : ",", sk_profile_system_name((int32_t)s), result->system_ms[s]);
+		fprintf(fp, "\n\t\t\t},\n");
+
+		fprintf(fp, "\t\t\t\"render_stats\": {");
+		for (int32_t v = 0; v < 9; v++)
+			fprintf(fp, "%s\n\t\t\t\t\"%s\": %.2f", v == 0 ? "" : ",", perf_stat_names[v], result->stats[v]);
+		fprintf(fp, "\n\t\t\t}\n");
+		fprintf(fp, "\t\t}%s\n", r + 1 < results.size() ? "," : "");
+	}
+	fprintf(fp, "\t]\n}\n");
+	fclose(fp);
+	return true;
+}
+
+///////////////////////////////////////////
+
+int main(int argc, char **argv) {
+	perf_args_t args = {};
+	args.frames = 300;
+	args.warmup = 30;
+	args.size   = 10;
+	args.width  = 1280;
+	args.height = 720;
+	args.out    = "perf.json";
+	for (int32_t a = 1; a + 1 < argc; a += 2) {
+		if      (strcmp(argv[a], "--frames") == 0) args.frames = atoi(argv[a+1]);
+		else if (strcmp(argv[a], "--warmup") == 0) args.warmup = atoi(argv[a+1]);
+		else if (strcmp(argv[a], "--size"  ) == 0) args.size   = atoi(argv[a+1]);
+		else if (strcmp(argv[a], "--width" ) == 0) args.width  = atoi(argv[a+1]);
+		else if (strcmp(argv[a], "--height") == 0) args.height = atoi(argv[a+1]);
+		else if (strcmp(argv[a], "--scene" ) == 0) args.scene  = argv[a+1];
+		else if (strcmp(argv[a], "--out"   ) == 0) args.out    = argv[a+1];
+		else { printf("Unknown argument %s\n", argv[a]); return 1; }
+	}
+
+	sk_settings_t settings = {};
+	settings.app_name                = "StereoKit Perf";
+	settings.assets_folder           = "Assets";
+	settings.display_preference      = display_mode_none;
+	settings.log_filter              = log_warning;
+	settings.disable_unfocused_sleep = true;
+	if (!sk_init(settings))
+		return 1;
+
+	perf_target = tex_create(tex_type_rendertarget, tex_format_rgba32);
+	tex_set_colors (perf_target, args.width, args.height, nullptr);
+	tex_add_zbuffer(perf_target);
+	perf_projection = matrix_perspective(90, (float)args.width / args.height, 0.01f, 50);
+
+	std::vector<perf_result_t> results;
+	for (int32_t i = 0; i < (int32_t)(sizeof(scenes)/sizeof(scenes[0])); i++) {
+		if (args.scene != nullptr && strcmp(args.scene, scenes[i].name) != 0) continue;
+		perf_result_t result = perf_run(&scenes[i], &args);
+		printf("%-16s %6d frames  avg %8.3f  p50 %8.3f  p90 %8.3f  p99 %8.3f ms\n",
+			result.name, result.frames, result.frame_ms_avg, result.frame_ms_p50, result.frame_ms_p90, result.frame_ms_p99);
+		results.push_back(result);
+	}
+
+	bool written = perf_write_json(args.out, &args, results);
+	if (!written) printf("Couldn't write %s\n", args.out);
+
+	tex_release(perf_target);
+	sk_shutdown();
+	return written ? 0 : 1;
+}
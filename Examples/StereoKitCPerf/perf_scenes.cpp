@@ -0,0 +1,196 @@
+#include "perf_scenes.h"
+
+#include <stereokit.h>
+#include <stereokit_ui.h>
+using namespace sk;
+
+#include <stdio.h>
+#include <math.h>
+
+///////////////////////////////////////////
+
+// Everything sits in a field in front of the camera, size items wide.
+static vec3 perf_grid_pos(int32_t i, int32_t size, float spacing) {
+	int32_t x = i % size;
+	int32_t y = (i / size) % size;
+	int32_t z = i / (size * size);
+	return vec3{
+		(x - size * 0.5f) * spacing,
+		(y - size * 0.5f) * spacing,
+		-1.5f - z * spacing };
+}
+
+///////////////////////////////////////////
+// Many meshes                           //
+///////////////////////////////////////////
+
+// Lots of individual mesh_draw calls across a handful of meshes and
+// materials, which mostly exercises sorting, culling and instancing.
+
+static mesh_t     meshes_mesh[3];
+static material_t meshes_mat [4];
+static int32_t    meshes_size;
+
+void perf_meshes_init(int32_t size) {
+	meshes_size    = size;
+	meshes_mesh[0] = mesh_gen_cube  (vec3{ 1,1,1 });
+	meshes_mesh[1] = mesh_gen_sphere(1);
+	meshes_mesh[2] = mesh_gen_cube  (vec3{ 1,1,1 }, 2);
+	for (int32_t i = 0; i < 4; i++) {
+		meshes_mat[i] = material_copy_id(default_id_material);
+		material_set_color(meshes_mat[i], "color", color_hsv(i / 4.0f, 0.6f, 0.9f, 1));
+	}
+}
+
+void perf_meshes_update(int32_t frame) {
+	int32_t count = meshes_size * meshes_size * meshes_size;
+	quat    rot   = quat_from_angles(0, frame * 2.0f, 0);
+	for (int32_t i = 0; i < count; i++) {
+		vec3 at = perf_grid_pos(i, meshes_size, 0.12f);
+		mesh_draw(meshes_mesh[i % 3], meshes_mat[(i / 3) % 4], matrix_trs(at, rot, vec3{ 0.05f,0.05f,0.05f }));
+	}
+}
+
+void perf_meshes_shutdown() {
+	for (int32_t i = 0; i < 3; i++) mesh_release    (meshes_mesh[i]);
+	for (int32_t i = 0; i < 4; i++) material_release(meshes_mat [i]);
+}
+
+///////////////////////////////////////////
+// Many models                           //
+///////////////////////////////////////////
+
+// Models made of several subsets each, so the cost of walking model nodes
+// shows up alongside the draw cost.
+
+static model_t    models_model[4];
+static mesh_t     models_mesh [2];
+static material_t models_mat  [2];
+static int32_t    models_size;
+
+void perf_models_init(int32_t size) {
+	models_size    = size;
+	models_mesh[0] = mesh_gen_cube  (vec3{ 1,1,1 });
+	models_mesh[1] = mesh_gen_sphere(1, 2);
+	models_mat [0] = material_copy_id(default_id_material);
+	models_mat [1] = material_copy_id(default_id_material);
+	material_set_color(models_mat[1], "color", color_hsv(0.6f, 0.5f, 0.9f, 1));
+
+	for (int32_t m = 0; m < 4; m++) {
+		models_model[m] = model_create();
+		for (int32_t s = 0; s < 4 + m * 2; s++) {
+			matrix tr = matrix_ts(vec3{ (s % 3) * 0.4f - 0.4f, (s / 3) * 0.4f, 0 }, vec3{ 0.3f,0.3f,0.3f });
+			model_add_subset(models_model[m], models_mesh[s % 2], models_mat[(s + m) % 2], tr);
+		}
+	}
+}
+
+void perf_models_update(int32_t frame) {
+	int32_t count = models_size * models_size * models_size;
+	for (int32_t i = 0; i < count; i++) {
+		vec3 at  = perf_grid_pos(i, models_size, 0.25f);
+		quat rot = quat_from_angles(0, frame * 1.0f + i * 10.0f, 0);
+		model_draw(models_model[i % 4], matrix_trs(at, rot, vec3{ 0.1f,0.1f,0.1f }));
+	}
+}
+
+void perf_models_shutdown() {
+	for (int32_t i = 0; i < 4; i++) model_release   (models_model[i]);
+	for (int32_t i = 0; i < 2; i++) mesh_release    (models_mesh [i]);
+	for (int32_t i = 0; i < 2; i++) material_release(models_mat  [i]);
+}
+
+///////////////////////////////////////////
+// Text heavy UI                         //
+///////////////////////////////////////////
+
+// Several windows full of labels, buttons and sliders, plus free floating
+// text, so layout and glyph generation get a workout.
+
+static pose_t  ui_poses[16];
+static float   ui_values[16];
+static int32_t ui_size;
+
+void perf_ui_init(int32_t size) {
+	ui_size = size > 16 ? 16 : size;
+	for (int32_t i = 0; i < ui_size; i++) {
+		float x = (i % 4 - 1.5f) * 0.3f;
+		float y = (i / 4 - 1.5f) * 0.3f;
+		ui_poses [i] = pose_t{ vec3{ x, y, -1.0f }, quat_lookat(vec3{ x, y, -1.0f }, vec3{ 0,0,0 }) };
+		ui_values[i] = 0.5f;
+	}
+}
+
+void perf_ui_update(int32_t frame) {
+	char text[64];
+	for (int32_t w = 0; w < ui_size; w++) {
+		snprintf(text, sizeof(text), "Window %d", w);
+		ui_window_begin(text, ui_poses[w], vec2{ 0.25f, 0 });
+		for (int32_t l = 0; l < 8; l++) {
+			snprintf(text, sizeof(text), "Label %d, frame %d", l, frame);
+			ui_label(text);
+			if (l % 2 == 0) ui_sameline();
+		}
+		snprintf(text, sizeof(text), "slider%d", w);
+		ui_hslider(text, ui_values[w], 0, 1);
+		ui_button("Button");
+		ui_sameline();
+		ui_button("Another");
+		ui_text("The quick brown fox jumps over the lazy dog, and then does it again for good measure.");
+		ui_window_end();
+	}
+
+	for (int32_t i = 0; i < ui_size * 8; i++) {
+		snprintf(text, sizeof(text), "Floating text %d, frame %d", i, frame);
+		text_add_at(text, matrix_t(perf_grid_pos(i, 8, 0.15f)));
+	}
+}
+
+void perf_ui_shutdown() {
+}
+
+///////////////////////////////////////////
+// Lines and sprites                     //
+///////////////////////////////////////////
+
+// Immediate mode lines and sprites, which both build their geometry on the
+// CPU each frame.
+
+static tex_t    sprites_tex;
+static sprite_t sprites_sprite[2];
+static int32_t  sprites_size;
+
+void perf_lines_sprites_init(int32_t size) {
+	sprites_size = size;
+
+	// A small procedural checker, so this doesn't rely on any assets.
+	color32 colors[32 * 32];
+	for (int32_t y = 0; y < 32; y++) {
+		for (int32_t x = 0; x < 32; x++) {
+			uint8_t c = ((x / 8 + y / 8) % 2) ? 255 : 64;
+			colors[x + y * 32] = color32{ c, c, 255, 255 };
+		}
+	}
+	sprites_tex = tex_create();
+	tex_set_colors(sprites_tex, 32, 32, colors);
+	sprites_sprite[0] = sprite_create(sprites_tex, sprite_type_single);
+	sprites_sprite[1] = sprite_create(sprites_tex, sprite_type_atlased);
+}
+
+void perf_lines_sprites_update(int32_t frame) {
+	int32_t count = sprites_size * sprites_size * sprites_size;
+	float   phase = frame * 0.05f;
+	for (int32_t i = 0; i < count; i++) {
+		vec3    at    = perf_grid_pos(i, sprites_size, 0.1f);
+		vec3    end   = vec3{ at.x + cosf(phase + i) * 0.04f, at.y + sinf(phase + i) * 0.04f, at.z };
+		color32 color = color_to_32(color_hsv((i % 64) / 64.0f, 0.8f, 1, 1));
+		line_add(at, end, color, color32{ 255,255,255,255 }, 0.005f);
+		sprite_draw(sprites_sprite[i % 2], matrix_ts(at, vec3{ 0.03f,0.03f,0.03f }));
+	}
+}
+
+void perf_lines_sprites_shutdown() {
+	sprite_release(sprites_sprite[0]);
+	sprite_release(sprites_sprite[1]);
+	tex_release   (sprites_tex);
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stdint.h>
+
+// A scripted scene for the headless benchmark. Scenes are built around a
+// camera at the origin looking down -Z, and get drawn the same way every
+// run, so numbers from different builds can be compared.
+struct perf_scene_t {
+	const char *name;
+	void (*init)    (int32_t size);
+	void (*update)  (int32_t frame);
+	void (*shutdown)(void);
+};
+
+void perf_meshes_init        (int32_t size);
+void perf_meshes_update      (int32_t frame);
+void perf_meshes_shutdown    ();
+
+void perf_models_init        (int32_t size);
+void perf_models_update      (int32_t frame);
+void perf_models_shutdown    ();
+
+void perf_ui_init            (int32_t size);
+void perf_ui_update          (int32_t frame);
+void perf_ui_shutdown        ();
+
+void perf_lines_sprites_init    (int32_t size);
+void perf_lines_sprites_update  (int32_t frame);
+void perf_lines_sprites_shutdown();
@@ -714,6 +714,30 @@ namespace StereoKit
 				NativeAPI.model_node_add_child(_model._inst, _nodeId, name, localTransform, mesh != null ? mesh._inst : IntPtr.Zero, material != null ? material._inst : IntPtr.Zero, solid ? 1 : 0));
 		}
 
+		/// <summary>The number of lower detail levels attached to this
+		/// node's visual with AddLod.</summary>
+		public int LodCount => NativeAPI.model_node_lod_count(_model._inst, _nodeId);
+
+		/// <summary>Adds a lower detail level to this node's visual. When the
+		/// visual covers less than `screenCoverage` of the screen's height,
+		/// StereoKit will draw this Mesh instead of the node's own Mesh. The
+		/// levels are kept sorted from most to least detailed, so they can be
+		/// added in any order. GLTF files using the MSFT_lod extension will
+		/// have these filled out automatically.</summary>
+		/// <param name="mesh">The lower detail Mesh. If this is null, the
+		/// visual won't be drawn at all once it's this small.</param>
+		/// <param name="screenCoverage">The fraction of the screen's height,
+		/// 0-1, that the visual's bounds need to drop below for this level to
+		/// be used.</param>
+		/// <param name="material">A Material to use at this level, or null
+		/// to keep using the node's own Material.</param>
+		public void AddLod(Mesh mesh, float screenCoverage, Material material = null)
+			=> NativeAPI.model_node_add_lod(_model._inst, _nodeId, mesh != null ? mesh._inst : IntPtr.Zero, material != null ? material._inst : IntPtr.Zero, screenCoverage);
+
+		/// <summary>Removes all lower detail levels from this node's visual,
+		/// so it always draws its own Mesh.</summary>
+		public void ClearLods() => NativeAPI.model_node_clear_lods(_model._inst, _nodeId);
+
 		private ModelNode From(int nodeId) => nodeId >= 0 ? new ModelNode(_model, nodeId) : null;
 	}
 
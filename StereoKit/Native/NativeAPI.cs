@@ -27,6 +27,10 @@ namespace StereoKit
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr      sk_version_name();
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern ulong       sk_version_id();
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern AppFocus    sk_app_focus();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int         sk_profile_system_count();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr      sk_profile_system_name(int system_index);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern double      sk_profile_system_total_ms(int system_index);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern ulong       sk_profile_system_steps(int system_index);
 
 		///////////////////////////////////////////
 
@@ -405,6 +409,9 @@ namespace StereoKit
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_set_visible        (IntPtr model, int node, [MarshalAs(UnmanagedType.Bool)] bool visible);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_set_material       (IntPtr model, int node, IntPtr material);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_set_mesh           (IntPtr model, int node, IntPtr mesh);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_add_lod            (IntPtr model, int node, IntPtr mesh, IntPtr material, float screen_coverage);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int    model_node_lod_count          (IntPtr model, int node);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_clear_lods         (IntPtr model, int node);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_set_transform_model(IntPtr model, int node, Matrix transform_model_space);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void   model_node_set_transform_local(IntPtr model, int node, Matrix transform_local_space);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr model_node_info_get           (IntPtr model, int node, [In] byte[] info_key_u8);
@@ -457,6 +464,14 @@ namespace StereoKit
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern float              render_get_scaling    ();
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_set_multisample(int display_tex_multisample);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int                render_get_multisample();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern RenderFrameStats   render_stats_frame();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int                render_stats_gpu_available();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern float              render_stats_gpu_ms(RenderPass pass);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern float              render_stats_gpu_total_ms();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern ulong              render_stats_gpu_frame();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_governor_enable(int enable, float target_hz, float min_scale, float max_scale);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int                render_governor_enabled();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern RenderGovernorDecision render_governor_get_decision();
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_override_capture_filter([MarshalAs(UnmanagedType.Bool)] bool use_override_filter, RenderLayer layer_filter);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern RenderLayer        render_get_capture_filter     ();
 		[return: MarshalAs(UnmanagedType.Bool)]
@@ -467,15 +482,26 @@ namespace StereoKit
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_enable_skytex  ([MarshalAs(UnmanagedType.Bool)] bool show_sky);
 		[return: MarshalAs(UnmanagedType.Bool)]
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern bool               render_enabled_skytex ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_set_sort       (int queue_start, int queue_end, RenderSort sort);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_add_mesh       (IntPtr mesh, IntPtr material, in Matrix transform, Color color, RenderLayer layer);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_add_mesh_instanced(IntPtr mesh, IntPtr material, [In] Matrix[] transforms, [In] Color[] colors, int count, RenderLayer layer);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_add_model      (IntPtr model, in Matrix transform, Color color, RenderLayer layer);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_add_model_mat  (IntPtr model, IntPtr material_override, in Matrix transform, Color color, RenderLayer layer);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_blit           (IntPtr to_rendertarget, IntPtr material);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_screenshot_pose([In] byte[] file_utf8, int file_quality_100, Pose viewpoint, int width, int height, float field_of_view_degrees);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_screenshot_file([In] byte[] file_utf8, int file_quality_100, Pose viewpoint, int width, int height, float field_of_view_degrees, [MarshalAs(UnmanagedType.FunctionPtr)] RenderOnScreenshotFileCallback on_complete, IntPtr context);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_screenshot_capture  ([MarshalAs(UnmanagedType.FunctionPtr)] RenderOnScreenshotCallback render_on_screenshot_callback, Pose viewpoint, int width, int height, float fov_degrees, TexFormat tex_format);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_screenshot_viewpoint([MarshalAs(UnmanagedType.FunctionPtr)] RenderOnScreenshotCallback render_on_screenshot_callback, Matrix camera, Matrix projection, int width, int height, RenderLayer layer_filter, RenderClear clear, Rect viewport, TexFormat tex_format);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_screenshot_viewpoints([MarshalAs(UnmanagedType.FunctionPtr)] RenderOnScreenshotCallback render_on_screenshot_callback, [In] ScreenshotView[] views, int view_count);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr             render_transient_target(int width, int height, TexFormat color_format, int multisample);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_to             (IntPtr to_rendertarget, in Matrix camera, in Matrix projection, RenderLayer layer_filter, RenderClear clear, Rect viewport);
 		//[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void render_get_device  (void **device, void **context);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int                render_list_create      ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_list_release     (int list);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_list_push        (int list);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_list_pop         ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_list_clear       (int list);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void               render_list_set_retained(int list, [MarshalAs(UnmanagedType.Bool)] bool retained);
 
 		///////////////////////////////////////////
 
@@ -673,6 +699,15 @@ namespace StereoKit
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int       assets_count                ();
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr    assets_get_index            (int index);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern AssetType assets_get_type             (int index);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern int       assets_task_timing_count    ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern AssetTaskTiming assets_task_timing_get(int index);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void      assets_set_upload_budget    (float budget_ms);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern float     assets_get_upload_budget    ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern AssetUploadStats assets_get_upload_stats();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void      assets_set_cache_folder     ([In] byte[] folder_utf8);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern IntPtr    assets_get_cache_folder     ();
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void      assets_set_cache_limit      (ulong max_bytes);
+		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern ulong     assets_get_cache_limit      ();
 		
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern AssetType asset_get_type              (IntPtr asset);
 		[DllImport(dll, CharSet = cSet, CallingConvention = call)] public static extern void      asset_set_id                (IntPtr asset, string id);
@@ -728,6 +728,99 @@ namespace StereoKit
 		All          = Color | Depth,
 	}
 
+	/// <summary>How StereoKit orders draws within a range of render queue
+	/// positions. A Material's queue position is based on its transparency
+	/// mode (1000 for opaque, 2000 for blend, 3000 for add) plus its queue
+	/// offset. Distances are measured from the primary camera.</summary>
+	public enum RenderSort {
+		/// <summary>Sort by Material and Mesh first to keep state changes to
+		/// a minimum, and then front to back. This is the default for opaque
+		/// and additive queues.</summary>
+		StateFirst   = 0,
+		/// <summary>Sort front to back first, and then by Material and Mesh.
+		/// This gets the most out of early depth rejection, at the cost of
+		/// more state changes.</summary>
+		DepthFirst,
+		/// <summary>Sort strictly back to front, and then by Material and
+		/// Mesh. This is the default for blended queues, as blending needs
+		/// far objects drawn before near ones.</summary>
+		BackToFront,
+	}
+
+	/// <summary>The groups of GPU work that StereoKit times separately, see
+	/// `Renderer.GpuMs`. The primary passes are split up by Material queue
+	/// position, the same ranges `Renderer.SetSort` uses by default.
+	/// </summary>
+	public enum RenderPass {
+		/// <summary>The primary view's opaque queue, everything before 2000
+		/// except the sky.</summary>
+		Opaque       = 0,
+		/// <summary>The skybox, drawn in the middle of the opaque queue.
+		/// </summary>
+		Sky,
+		/// <summary>The primary view's blend queue, from 2000 up to 3000.
+		/// </summary>
+		Blend,
+		/// <summary>The primary view's additive queue, and anything queued
+		/// after it.</summary>
+		Add,
+		/// <summary>Everything drawn for `Renderer.RenderTo`.</summary>
+		Viewpoint,
+		/// <summary>Everything drawn for screenshots.</summary>
+		Screenshot,
+		/// <summary>Everything drawn by `Renderer.Blit`.</summary>
+		Blit,
+		/// <summary>The number of passes, not a pass itself.</summary>
+		Max,
+	}
+
+	/// <summary>What the dynamic resolution governor did with the render
+	/// scaling on its most recent frame. See `Renderer.GovernorDecision`.
+	/// </summary>
+	public enum RenderGovernor {
+		/// <summary>The governor is off, and render scaling is left entirely
+		/// to the application.</summary>
+		Disabled     = 0,
+		/// <summary>The scaling was left alone, see `RenderGovernorReason`
+		/// for why.</summary>
+		Hold,
+		/// <summary>GPU time was consistently over budget, and the GPU was
+		/// the slower side, so the scaling was lowered.</summary>
+		Lower,
+		/// <summary>Frames were consistently well under budget, so the
+		/// scaling was raised.</summary>
+		Raise,
+	}
+
+	/// <summary>Why the dynamic resolution governor made its most recent
+	/// decision. See `Renderer.GovernorDecision`.</summary>
+	public enum RenderGovernorReason {
+		/// <summary>The governor is off.</summary>
+		None         = 0,
+		/// <summary>This GPU can't time frames, and without GPU time there's
+		/// no telling whether the scaling matters, so it's left alone.
+		/// </summary>
+		NoGpuTiming,
+		/// <summary>The scaling changed recently, and the governor is
+		/// waiting for frame times to settle before judging it.</summary>
+		Settling,
+		/// <summary>Frame time is between the raise and lower thresholds.
+		/// </summary>
+		InBudget,
+		/// <summary>GPU time is over budget, and at least as long as CPU
+		/// time. Scaling is lowered once this lasts long enough.</summary>
+		GpuBound,
+		/// <summary>Frames are over budget, but the CPU is the slower side,
+		/// so lowering the scaling wouldn't help.</summary>
+		CpuBound,
+		/// <summary>Frame time is well under budget. Scaling is raised once
+		/// this lasts long enough.</summary>
+		UnderBudget,
+		/// <summary>The governor would change the scaling, but it's already
+		/// at the minimum or maximum scale it was given.</summary>
+		ScaleLimit,
+	}
+
 	/// <summary>The projection mode used by StereoKit for the main camera! You
 	/// can use this with Renderer.Projection. These options are only
 	/// available in flatscreen mode, as MR headsets provide very
@@ -340,6 +340,163 @@ namespace StereoKit
 		}
 	}
 
+	/// <summary>A single view for capturing several screenshots at once with
+	/// `Renderer.Screenshot`. These line up with the parameters of the
+	/// single viewpoint overload.</summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct ScreenshotView
+	{
+		/// <summary>A TRS matrix representing the location and orientation
+		/// of the camera. This gets inverted later on, so no need to do it
+		/// yourself.</summary>
+		public Matrix      camera;
+		/// <summary>The projection matrix for this view.</summary>
+		public Matrix      projection;
+		/// <summary>Width of the screenshot, in pixels.</summary>
+		public int         width;
+		/// <summary>Height of the screenshot, in pixels.</summary>
+		public int         height;
+		/// <summary>Which layers to render for this view.</summary>
+		public RenderLayer layerFilter;
+		/// <summary>If and how the surface should be cleared first.</summary>
+		public RenderClear clear;
+		/// <summary>Region of the surface to draw to, in pixels. A zero
+		/// width draws to the whole surface.</summary>
+		public Rect        viewport;
+		/// <summary>The pixel format of the color data.</summary>
+		public TexFormat   texFormat;
+		/// <summary>Passed through to the native callback, the managed
+		/// wrapper uses this itself.</summary>
+		internal IntPtr    context;
+	}
+
+	/// <summary>Counts of what the renderer did over the most recently
+	/// finished frame, across the primary display and any `Renderer.RenderTo`
+	/// or screenshot views.</summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct RenderFrameStats
+	{
+		/// <summary>Draw calls submitted to the GPU.</summary>
+		public int drawCalls;
+		/// <summary>Instances drawn across all those draw calls.</summary>
+		public int drawInstances;
+		/// <summary>How many times the bound mesh changed.</summary>
+		public int swapsMesh;
+		/// <summary>How many times the bound material changed.</summary>
+		public int swapsMaterial;
+		/// <summary>How many times a material's textures were bound.
+		/// </summary>
+		public int swapsTexture;
+		/// <summary>Items skipped for being outside the view.</summary>
+		public int culled;
+		/// <summary>Items skipped for being behind an occluder mesh.
+		/// </summary>
+		public int occluded;
+		/// <summary>Size of the instance data ring, in instances.</summary>
+		public int instanceRingSize;
+		/// <summary>Times the instance ring had to wait on the GPU.</summary>
+		public int instanceRingStalls;
+		/// <summary>Offscreen render targets that were reused from the
+		/// pool.</summary>
+		public int targetPoolHits;
+		/// <summary>Offscreen render targets the pool had to create.
+		/// </summary>
+		public int targetPoolMisses;
+		/// <summary>Model visuals drawn at full detail.</summary>
+		public int lodDraws0;
+		/// <summary>Model visuals drawn at LOD 1.</summary>
+		public int lodDraws1;
+		/// <summary>Model visuals drawn at LOD 2.</summary>
+		public int lodDraws2;
+		/// <summary>Model visuals drawn at LOD 3.</summary>
+		public int lodDraws3;
+		/// <summary>Model visuals drawn at LOD 4.</summary>
+		public int lodDraws4;
+		/// <summary>Model visuals drawn at LOD 5.</summary>
+		public int lodDraws5;
+		/// <summary>Model visuals drawn at LOD 6.</summary>
+		public int lodDraws6;
+		/// <summary>Model visuals drawn at LOD 7 or further.</summary>
+		public int lodDraws7;
+	}
+
+	/// <summary>How long a finished asset loading task took, and where that
+	/// time went.</summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct AssetTaskTiming
+	{
+		/// <summary>The type of asset the task was loading.</summary>
+		public AssetType type;
+		/// <summary>The priority the task was queued with.</summary>
+		public int priority;
+		/// <summary>The task's final estimate of how much work it was.
+		/// </summary>
+		public int complexity;
+		/// <summary>Time between the task being queued, and a thread first
+		/// picking it up.</summary>
+		public float waitMs;
+		/// <summary>Time spent running on the asset threads.</summary>
+		public float threadMs;
+		/// <summary>Time spent running on the main thread, uploading to the
+		/// GPU.</summary>
+		public float gpuMs;
+		/// <summary>Time from being queued to being finished.</summary>
+		public float totalMs;
+	}
+
+	/// <summary>Counters for the GPU uploads StereoKit does for assets on
+	/// the main thread. A step is one pass of the asset system, normally
+	/// once per frame.</summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct AssetUploadStats
+	{
+		/// <summary>Upload jobs left waiting after the last step.</summary>
+		public int pending;
+		/// <summary>Upload jobs run during the last step.</summary>
+		public int uploaded;
+		/// <summary>Time the last step spent on upload jobs.</summary>
+		public float lastMs;
+		/// <summary>Longest any step has spent on upload jobs.</summary>
+		public float maxMs;
+		/// <summary>Steps that ran out of budget and left jobs for later.
+		/// </summary>
+		public int deferredSteps;
+		/// <summary>Steps that went over budget, because a single job took
+		/// longer than the whole budget.</summary>
+		public int hitchSteps;
+		/// <summary>Upload jobs run since StereoKit started.</summary>
+		public long totalUploaded;
+	}
+
+	/// <summary>A snapshot of the dynamic resolution governor's most recent
+	/// frame, handy for logging or for showing on a debug overlay. Times are
+	/// smoothed over several frames, and are in milliseconds.</summary>
+	[StructLayout(LayoutKind.Sequential)]
+	public struct RenderGovernorDecision
+	{
+		/// <summary>What the governor did with the scaling this frame.
+		/// </summary>
+		public RenderGovernor       action;
+		/// <summary>Why the governor did what it did this frame.</summary>
+		public RenderGovernorReason reason;
+		/// <summary>The render scaling after this decision.</summary>
+		public float                scale;
+		/// <summary>Smoothed CPU time per frame, from the system profile
+		/// counters.</summary>
+		public float                cpuMs;
+		/// <summary>Smoothed GPU time per frame, or zero if GPU timing isn't
+		/// available.</summary>
+		public float                gpuMs;
+		/// <summary>The time one frame has at the target frame rate.
+		/// </summary>
+		public float                budgetMs;
+		/// <summary>The frame this decision was made on.</summary>
+		public ulong                frame;
+		/// <summary>The last frame the governor changed the scaling on.
+		/// </summary>
+		public ulong                changedFrame;
+	}
+
 	/// <summary>Used to represent lines for the line drawing functions! This is just a snapshot of
 	/// information about each individual point on a line.</summary>
 	[StructLayout(LayoutKind.Sequential)]
@@ -468,6 +625,9 @@ namespace StereoKit
 	[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
 	internal delegate void RenderOnScreenshotCallback(IntPtr data, int width, int height, IntPtr context);
 
+	[UnmanagedFunctionPointer(CallingConvention.Cdecl)]
+	internal delegate void RenderOnScreenshotFileCallback(IntPtr file_utf8, int success, IntPtr context);
+
 	/// <summary>A callback for receiving the color data of a screenshot, instead
 	/// of saving it directly to a file.</summary>
 	/// <param name="data">The pointer to the color data. A fare warning that the
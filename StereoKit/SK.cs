@@ -49,6 +49,28 @@ namespace StereoKit
 		/// visible behind the app that _does_ have focus. </summary>
 		public static AppFocus AppFocus => NativeAPI.sk_app_focus();
 
+		/// <summary>How many of StereoKit's internal systems have profile
+		/// information, see `SK.ProfileSystemName` and `SK.ProfileSystemTotalMs`.
+		/// </summary>
+		public static int ProfileSystemCount => NativeAPI.sk_profile_system_count();
+
+		/// <summary>The name of one of StereoKit's internal systems, such as
+		/// "Renderer" or "Input".</summary>
+		/// <param name="index">Index of the system, from 0 up to
+		/// `SK.ProfileSystemCount`.</param>
+		/// <returns>The system's name, or null if the index is out of range.
+		/// </returns>
+		public static string ProfileSystemName(int index) => Marshal.PtrToStringAnsi(NativeAPI.sk_profile_system_name(index));
+
+		/// <summary>Total time a system has spent in its step function since
+		/// StereoKit started, in milliseconds. Compare two readings to see
+		/// how long it took over a span of frames.</summary>
+		/// <param name="index">Index of the system, from 0 up to
+		/// `SK.ProfileSystemCount`.</param>
+		/// <returns>Milliseconds, or zero if the index is out of range.
+		/// </returns>
+		public static double ProfileSystemTotalMs(int index) => NativeAPI.sk_profile_system_total_ms(index);
+
 		/// <summary>On Android systems, this must be assigned right away,
 		/// before _any_ access to SK methods. When using Xamarin.Essentials or
 		/// Microsoft.Maui.Essentials, this will be done automatically. This
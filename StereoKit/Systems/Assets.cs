@@ -36,6 +36,57 @@ namespace StereoKit
 		/// complete.</param>
 		public static void BlockForPriority(int priority) => NativeAPI.assets_block_for_priority(priority);
 
+		/// <summary>Timings for the most recently finished asset loading
+		/// tasks, oldest first. Only a limited number of recent tasks are
+		/// kept.</summary>
+		public static AssetTaskTiming[] TaskTimings { get {
+			AssetTaskTiming[] result = new AssetTaskTiming[NativeAPI.assets_task_timing_count()];
+			for (int i = 0; i < result.Length; i++)
+				result[i] = NativeAPI.assets_task_timing_get(i);
+			return result;
+		} }
+
+		/// <summary>How many milliseconds each frame StereoKit may spend on
+		/// the main thread uploading loaded assets to the GPU. Anything left
+		/// over waits for the next frame, highest priority first. A single
+		/// upload can still go over. 0 or less removes the limit. Default is
+		/// 4.</summary>
+		public static float UploadBudgetMs
+		{
+			get => NativeAPI.assets_get_upload_budget();
+			set => NativeAPI.assets_set_upload_budget(value);
+		}
+
+		/// <summary>Counters describing how asset uploads have been fitting
+		/// into UploadBudgetMs, useful for spotting hitches.</summary>
+		public static AssetUploadStats UploadStats => NativeAPI.assets_get_upload_stats();
+
+		/// <summary>An optional folder where StereoKit keeps preprocessed
+		/// copies of loaded assets, like decoded image files, converted
+		/// cubemaps with their lighting, model meshes and mesh BVHs. Later
+		/// launches can then skip that work. Entries are matched against the
+		/// source file's contents, so edited files just get processed again.
+		/// Textures made from memory aren't cached. Set this before loading
+		/// any assets. It's off (null) by default, and resets on shutdown.
+		/// </summary>
+		public static string CacheFolder
+		{
+			get {
+				IntPtr folder = NativeAPI.assets_get_cache_folder();
+				return folder == IntPtr.Zero ? null : NativeHelper.FromUtf8(folder); }
+			set => NativeAPI.assets_set_cache_folder(value == null ? null : NativeHelper.ToUtf8(value));
+		}
+
+		/// <summary>The most bytes the CacheFolder may hold. When a new entry
+		/// pushes it over, the least recently used entries are deleted. 0
+		/// removes the limit. Default is 1GB, and it resets on shutdown.
+		/// </summary>
+		public static ulong CacheLimit
+		{
+			get => NativeAPI.assets_get_cache_limit();
+			set => NativeAPI.assets_set_cache_limit(value);
+		}
+
 		/// <summary>A list of supported model format extensions. This pairs
 		/// pretty well with `Platform.FilePicker` when attempting to load a
 		/// `Model`!</summary>
@@ -12,6 +12,7 @@ namespace StereoKit
 		/// <summary>A queue is used to prevent premature garbage collection
 		/// of the user-defined callbacks.</summary>
 		private static Queue<RenderOnScreenshotCallback> _renderCaptureCallbacks;
+		private static Queue<RenderOnScreenshotFileCallback> _renderFileCallbacks;
 
 		/// <summary>Set a cubemap skybox texture for rendering a background! This is only visible on Opaque
 		/// displays, since transparent displays have the real world behind them already! StereoKit has a
@@ -73,6 +74,61 @@ namespace StereoKit
 			set => NativeAPI.render_set_multisample(value);
 		}
 
+		/// <summary>Draw calls, state changes and culling counts from the
+		/// most recently finished frame.</summary>
+		public static RenderFrameStats FrameStats => NativeAPI.render_stats_frame();
+
+		/// <summary>Can this GPU and graphics API time StereoKit's render
+		/// passes? If not, `Renderer.GpuMs` and `Renderer.GpuTotalMs` will
+		/// always be zero.</summary>
+		public static bool GpuStatsAvailable => NativeAPI.render_stats_gpu_available() > 0;
+
+		/// <summary>The total GPU time of every pass StereoKit timed, in
+		/// milliseconds. GPU timings come back a frame or two late, see
+		/// `Renderer.GpuStatsFrame` for which frame this is from.</summary>
+		public static float GpuTotalMs => NativeAPI.render_stats_gpu_total_ms();
+
+		/// <summary>The frame that `Renderer.GpuMs` and `Renderer.GpuTotalMs`
+		/// were measured on.</summary>
+		public static ulong GpuStatsFrame => NativeAPI.render_stats_gpu_frame();
+
+		/// <summary>How long a group of render passes took on the GPU, in
+		/// milliseconds. Passes that ran several times in a frame, like a
+		/// few screenshots, are added together.</summary>
+		/// <param name="pass">Which group of passes to check.</param>
+		/// <returns>GPU time in milliseconds, or zero if GPU timing isn't
+		/// available.</returns>
+		public static float GpuMs(RenderPass pass) => NativeAPI.render_stats_gpu_ms(pass);
+
+		/// <summary>Is the dynamic resolution governor currently adjusting
+		/// `Renderer.Scaling`? See `Renderer.EnableGovernor`.</summary>
+		public static bool GovernorEnabled => NativeAPI.render_governor_enabled() > 0;
+
+		/// <summary>What the dynamic resolution governor saw and did on its
+		/// most recent frame. This is a good thing to log, or to show on a
+		/// debug overlay, when tuning the governor's bounds.</summary>
+		public static RenderGovernorDecision GovernorDecision => NativeAPI.render_governor_get_decision();
+
+		/// <summary>Turns on a governor that adjusts `Renderer.Scaling` every
+		/// frame to hold a target frame rate. It lowers the scaling when
+		/// frames are consistently over budget, raises it slowly when they're
+		/// consistently well under, and waits for each change to settle, since
+		/// changing the scaling is itself costly. While it's on, it will
+		/// overwrite any scaling set manually.</summary>
+		/// <param name="targetHz">The frame rate to hold, or 0 to use the
+		/// display's refresh rate.</param>
+		/// <param name="minScale">The lowest scaling the governor may pick.
+		/// </param>
+		/// <param name="maxScale">The highest scaling the governor may pick.
+		/// </param>
+		public static void EnableGovernor(float targetHz = 0, float minScale = 0.5f, float maxScale = 1.0f)
+			=> NativeAPI.render_governor_enable(1, targetHz, minScale, maxScale);
+
+		/// <summary>Turns off the dynamic resolution governor, leaving
+		/// `Renderer.Scaling` wherever it was last set.</summary>
+		public static void DisableGovernor()
+			=> NativeAPI.render_governor_enable(0, 0, 0, 0);
+
 		/// <summary>This tells if CaptureFilter has been overridden to a
 		/// specific value via `Renderer.OverrideCaptureFilter`.</summary>
 		public static bool HasCaptureFilter => NativeAPI.render_has_capture_filter();
@@ -162,6 +218,30 @@ namespace StereoKit
 		public static void Add(Mesh mesh, Material material, Matrix transform, Color colorLinear, RenderLayer layer = RenderLayer.Layer0)
 			=> NativeAPI.render_add_mesh(mesh._inst, material._inst, transform, colorLinear, layer);
 
+		/// <summary>Adds a batch of Mesh instances to the render queue for
+		/// this frame in a single call! This is much cheaper than calling
+		/// Add once per instance, as the whole batch becomes a single item in
+		/// the render queue. If the Hierarchy has a transform on it, that
+		/// transform is combined with each Matrix provided here.</summary>
+		/// <param name="mesh">A valid Mesh you wish to draw.</param>
+		/// <param name="material">A Material to apply to the Mesh.</param>
+		/// <param name="transforms">One Matrix per instance, each of which
+		/// will transform the mesh from Model Space into the current
+		/// Hierarchy Space.</param>
+		/// <param name="colorsLinear">Optional per-instance linear space
+		/// color values, this must be null, or the same length as
+		/// transforms. If null, all instances will be white.</param>
+		/// <param name="layer">All visuals are rendered using a layer 
+		/// bit-flag. By default, all layers are rendered, but this can be 
+		/// useful for filtering out objects for different rendering 
+		/// purposes!</param>
+		public static void AddInstanced(Mesh mesh, Material material, Matrix[] transforms, Color[] colorsLinear = null, RenderLayer layer = RenderLayer.Layer0)
+		{
+			if (colorsLinear != null && colorsLinear.Length < transforms.Length)
+				throw new ArgumentException("colorsLinear must have at least as many elements as transforms!");
+			NativeAPI.render_add_mesh_instanced(mesh._inst, material._inst, transforms, colorsLinear, transforms.Length, layer);
+		}
+
 		/// <summary>Adds a Model to the render queue for this frame! If the
 		/// Hierarchy has a transform on it, that transform is combined with
 		/// the Matrix provided here.</summary>
@@ -211,6 +291,21 @@ namespace StereoKit
 		public static void SetClip(float nearPlane = 0.08f, float farPlane = 50)
 			=> NativeAPI.render_set_clip(nearPlane, farPlane);
 
+		/// <summary>Sets how draws are ordered for Materials whose queue
+		/// position falls within the provided range. A Material's queue
+		/// position is 1000 for opaque, 2000 for blend, and 3000 for add,
+		/// plus its QueueOffset. Later calls take priority over earlier ones
+		/// where ranges overlap, and this applies to items added after the
+		/// call.</summary>
+		/// <param name="queueStart">The first queue position in the range.
+		/// </param>
+		/// <param name="queueEnd">The end of the range, this queue position
+		/// is not included.</param>
+		/// <param name="sort">How draws in this range should be ordered.
+		/// </param>
+		public static void SetSort(int queueStart, int queueEnd, RenderSort sort)
+			=> NativeAPI.render_set_sort(queueStart, queueEnd, sort);
+
 		/// <summary>Only works for flatscreen! This updates the camera's 
 		/// projection matrix with a new field of view.
 		/// 
@@ -267,8 +362,8 @@ namespace StereoKit
 		/// <param name="height">Size of the screenshot vertically, in pixels.</param>
 		/// <param name="filename">Filename to write the screenshot to! This
 		/// will be a PNG if the extension ends with (case insensitive)
-		/// ".png", and will be a 90 quality JPEG if it ends with anything
-		/// else.</param>
+		/// ".png", a QOI if it ends with ".qoi", and will be a 90 quality
+		/// JPEG if it ends with anything else.</param>
 		[Obsolete("For removal in v0.4. Use the overload that takes filename first.")]
 		public static void Screenshot(Vec3 from, Vec3 at, int width, int height, string filename)
 			=> NativeAPI.render_screenshot_pose(NativeHelper.ToUtf8(filename), 90, Pose.LookAt(from, at), width, height, 90);
@@ -280,8 +375,8 @@ namespace StereoKit
 		/// </summary>
 		/// <param name="filename">Filename to write the screenshot to! This
 		/// will be a PNG if the extension ends with (case insensitive)
-		/// ".png", and will be a 90 quality JPEG if it ends with anything
-		/// else.</param>
+		/// ".png", a QOI if it ends with ".qoi", and will be a 90 quality
+		/// JPEG if it ends with anything else.</param>
 		/// <param name="from">Viewpoint location.</param>
 		/// <param name="at">Direction the viewpoint is looking at.</param>
 		/// <param name="width">Size of the screenshot horizontally, in pixels.
@@ -299,7 +394,8 @@ namespace StereoKit
 		/// depending on the filename extension provided.</summary>
 		/// <param name="filename">Filename to write the screenshot to! This
 		/// will be a PNG if the extension ends with (case insensitive)
-		/// ".png", and will be a JPEG if it ends with anything else.</param>
+		/// ".png", a QOI if it ends with ".qoi", and will be a JPEG if it
+		/// ends with anything else.</param>
 		/// <param name="fileQuality">For JPEG files, this is the compression
 		/// quality of the file from 0-100, 100 being highest quality, 0 being
 		/// smallest size. SK uses a default of 90 here.</param>
@@ -319,8 +415,8 @@ namespace StereoKit
 		/// depending on the filename extension provided.</summary>
 		/// <param name="filename">Filename to write the screenshot to! This
 		/// will be a PNG if the extension ends with (case insensitive)
-		/// ".png", and will be a 90 quality JPEG if it ends with anything
-		/// else.</param>
+		/// ".png", a QOI if it ends with ".qoi", and will be a 90 quality
+		/// JPEG if it ends with anything else.</param>
 		/// <param name="viewpoint">Viewpoint location and orientation.</param>
 		/// <param name="width">Size of the screenshot horizontally, in pixels.
 		/// </param>
@@ -331,6 +427,40 @@ namespace StereoKit
 		public static void Screenshot(string filename, Pose viewpoint, int width, int height, float fieldOfViewDegrees = 90)
 			=> NativeAPI.render_screenshot_pose(NativeHelper.ToUtf8(filename), 90, viewpoint, width, height, fieldOfViewDegrees);
 
+		/// <summary>Schedules a screenshot for the end of the frame, and
+		/// lets you know once the file has been written. Encoding and
+		/// writing the file happens on a separate thread, so this won't
+		/// hold up the frame, and `onComplete` is called from the main
+		/// thread during a later frame.</summary>
+		/// <param name="filename">Filename to write the screenshot to! This
+		/// will be a PNG if the extension ends with (case insensitive)
+		/// ".png", a QOI if it ends with ".qoi", and will be a JPEG if it
+		/// ends with anything else. QOI is lossless like PNG, but much
+		/// faster to write.</param>
+		/// <param name="fileQuality">For JPEG files, this is the compression
+		/// quality of the file from 0-100, 100 being highest quality, 0 being
+		/// smallest size. SK uses a default of 90 here.</param>
+		/// <param name="viewpoint">Viewpoint location and orientation.</param>
+		/// <param name="width">Size of the screenshot horizontally, in pixels.
+		/// </param>
+		/// <param name="height">Size of the screenshot vertically, in pixels.
+		/// </param>
+		/// <param name="fieldOfViewDegrees">The angle of the viewport, in 
+		/// degrees.</param>
+		/// <param name="onComplete">Called with the filename, and whether or
+		/// not the file was written successfully.</param>
+		public static void Screenshot(string filename, int fileQuality, Pose viewpoint, int width, int height, float fieldOfViewDegrees, Action<string, bool> onComplete)
+		{
+			if (_renderFileCallbacks is null) _renderFileCallbacks = new Queue<RenderOnScreenshotFileCallback>();
+			RenderOnScreenshotFileCallback renderFileCallback = (IntPtr file, int success, IntPtr context) =>
+			{
+				onComplete?.Invoke(NativeHelper.FromUtf8(file), success > 0);
+				_ = _renderFileCallbacks.Dequeue();
+			};
+			_renderFileCallbacks.Enqueue(renderFileCallback);
+			NativeAPI.render_screenshot_file(NativeHelper.ToUtf8(filename), fileQuality, viewpoint, width, height, fieldOfViewDegrees, renderFileCallback, IntPtr.Zero);
+		}
+
 		/// <summary>Schedules a screenshot for the end of the frame! The view
 		/// will be rendered from the given position at the given point, with a
 		/// resolution the same size as the screen's surface. This overload
@@ -400,6 +530,50 @@ namespace StereoKit
 			NativeAPI.render_screenshot_viewpoint(renderCaptureCallback, camera, projection, width, height, layerFilter, clear, viewport, texFormat);
 		}
 
+		/// <summary>Schedules several screenshots for the end of the frame,
+		/// one for each view. The color data for each is read back from the
+		/// GPU without stalling the frame, so `onScreenshot` is called a
+		/// few frames later, once per view, in the same order as `views`.
+		/// </summary>
+		/// <param name="onScreenshot">Outputs a reference to the color data
+		/// and its size for each view.</param>
+		/// <param name="views">The viewpoints to capture.</param>
+		public static void Screenshot(ScreenshotCallback onScreenshot, ScreenshotView[] views)
+		{
+			if (_renderCaptureCallbacks is null) _renderCaptureCallbacks = new Queue<RenderOnScreenshotCallback>();
+			RenderOnScreenshotCallback renderCaptureCallback = (IntPtr dataPtr, int w, int h, IntPtr context) =>
+			{
+				onScreenshot.Invoke(dataPtr, w, h);
+				_ = _renderCaptureCallbacks.Dequeue();
+			};
+			// Each view's callback dequeues one entry, so the delegate stays
+			// alive until the last view is delivered.
+			for (int i = 0; i < views.Length; i++)
+				_renderCaptureCallbacks.Enqueue(renderCaptureCallback);
+			NativeAPI.render_screenshot_viewpoints(renderCaptureCallback, views, views.Length);
+		}
+
+		/// <summary>Gets a rendertarget texture with a depth buffer from a
+		/// pool of transient targets, which is handy for things like
+		/// portals and mirrors that need a fresh surface every frame. The
+		/// target is yours until the end of the frame, after which it may be
+		/// handed out again to anyone asking for the same size and format,
+		/// so don't hold onto it past that! Targets that haven't been asked
+		/// for in a few frames are released.</summary>
+		/// <param name="width">Width of the target, in pixels.</param>
+		/// <param name="height">Height of the target, in pixels.</param>
+		/// <param name="colorFormat">Pixel format of the color surface.
+		/// </param>
+		/// <param name="multisample">Number of MSAA samples for the target,
+		/// 1 for no multisampling.</param>
+		/// <returns>A rendertarget texture, or null if the size was invalid.
+		/// </returns>
+		public static Tex TransientTarget(int width, int height, TexFormat colorFormat = TexFormat.Rgba32, int multisample = 1)
+		{
+			IntPtr ptr = NativeAPI.render_transient_target(width, height, colorFormat, multisample);
+			return ptr == IntPtr.Zero ? null : new Tex(ptr);
+		}
+
 		/// <summary>This renders the current scene to the indicated 
 		/// rendertarget texture, from the specified viewpoint. This call 
 		/// enqueues a render that occurs immediately before the screen 
@@ -5,6 +5,7 @@
 namespace sk {
 
 void     sk_assert_thread_valid();
+bool32_t sk_is_main_thread     ();
 bool32_t sk_has_stepped        ();
 bool32_t sk_is_initialized     ();
 bool32_t sk_use_manual_pos     ();
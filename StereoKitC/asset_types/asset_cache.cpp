@@ -0,0 +1,602 @@
+#ifndef _CRT_SECURE_NO_WARNINGS
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "asset_cache.h"
+#include "../log.h"
+#include "../sk_memory.h"
+#include "../platforms/platform_utils.h"
+#include "../libraries/stref.h"
+#include "../libraries/ferr_hash.h"
+#include "../libraries/atomic_util.h"
+#include "../libraries/ferr_thread.h"
+#include "../libraries/array.h"
+
+#define __STDC_FORMAT_MACROS
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(SK_OS_WINDOWS)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+	#define SK_ASSET_CACHE_MMAP
+#elif defined(SK_OS_LINUX) || defined(SK_OS_ANDROID)
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <dirent.h>
+	#define SK_ASSET_CACHE_MMAP
+#elif defined(SK_OS_WINDOWS_UWP)
+	#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+	#endif
+	#include <windows.h>
+#endif
+
+namespace sk {
+
+///////////////////////////////////////////
+
+// Bump this whenever the layout of anything that goes into the cache
+// changes, like vert_t, so old entries stop matching.
+const uint32_t asset_cache_version   = 1;
+const char     asset_cache_magic[4]  = { 'S', 'K', 'A', 'C' };
+const uint64_t asset_cache_alignment = 16;
+const uint64_t asset_cache_limit_default = 1024ull * 1024 * 1024;
+
+#if defined(SKG_OPENGL)
+const char *asset_cache_backend = "gl";
+#else
+const char *asset_cache_backend = "d3d11";
+#endif
+
+struct asset_cache_header_t {
+	char     magic[4];
+	uint32_t version;
+	uint64_t build;        // Backend, since some data like cubemap faces is stored the way that backend wants it
+	uint64_t key;
+	uint64_t content_hash;
+	uint32_t section_count;
+	uint32_t reserved;
+};
+
+struct asset_cache_entry_t {
+	uint32_t tag;
+	uint32_t reserved;
+	uint64_t offset;
+	uint64_t size;
+};
+
+struct asset_cache_t {
+	const uint8_t             *data;
+	uint64_t                   size;
+	const asset_cache_entry_t *sections;
+	uint32_t                   section_count;
+	bool32_t                   mapped;
+#if defined(SK_OS_WINDOWS)
+	HANDLE                     file;
+	HANDLE                     mapping;
+#endif
+};
+
+// What we know of the entries in the cache folder, for evicting the least
+// recently used ones when the cache grows past its limit.
+struct asset_cache_file_t {
+	uint64_t key;
+	uint64_t size;
+	uint64_t used; // Higher is more recently written or hit
+};
+
+// The folder and the file list are shared with the asset threads, so both
+// are only touched under asset_cache_mtx.
+char                       *asset_cache_folder      = nullptr;
+int32_t                     asset_cache_write_count = 0;
+ft_mutex_t                  asset_cache_mtx         = nullptr;
+array_t<asset_cache_file_t> asset_cache_files       = {};
+uint64_t                    asset_cache_size        = 0;
+uint64_t                    asset_cache_limit       = asset_cache_limit_default;
+uint64_t                    asset_cache_stamp       = 0;
+
+///////////////////////////////////////////
+
+void asset_cache_make_folder(const char *folder) {
+#if defined(SK_OS_WINDOWS) || defined(SK_OS_WINDOWS_UWP)
+	int32_t  wsize   = MultiByteToWideChar(CP_UTF8, 0, folder, -1, nullptr, 0);
+	wchar_t *wfolder = sk_malloc_t(wchar_t, wsize);
+	MultiByteToWideChar(CP_UTF8, 0, folder, -1, wfolder, wsize);
+	CreateDirectoryW(wfolder, nullptr);
+	sk_free(wfolder);
+#elif defined(SK_OS_LINUX) || defined(SK_OS_ANDROID)
+	mkdir(folder, 0755);
+#endif
+}
+
+///////////////////////////////////////////
+
+// Asset threads only exist between assets_init and assets_shutdown, and
+// the mutex is created on the main thread before then, so without one
+// there's nobody to race with.
+void asset_cache_lock() {
+	if (asset_cache_mtx == nullptr) asset_cache_mtx = ft_mutex_create();
+	ft_mutex_lock(asset_cache_mtx);
+}
+void asset_cache_unlock() {
+	ft_mutex_unlock(asset_cache_mtx);
+}
+
+///////////////////////////////////////////
+
+void asset_cache_delete_file(const char *filename) {
+#if defined(SK_OS_WINDOWS) || defined(SK_OS_WINDOWS_UWP)
+	int32_t  wsize     = MultiByteToWideChar(CP_UTF8, 0, filename, -1, nullptr, 0);
+	wchar_t *wfilename = sk_malloc_t(wchar_t, wsize);
+	MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename, wsize);
+	DeleteFileW(wfilename);
+	sk_free(wfilename);
+#else
+	remove(filename);
+#endif
+}
+
+///////////////////////////////////////////
+
+bool asset_cache_parse_name(const char *name, uint64_t *out_key) {
+	return strlen(name) == 20
+		&& string_endswith(name, ".skc")
+		&& sscanf(name, "%16" SCNx64, out_key) == 1;
+}
+
+///////////////////////////////////////////
+
+// Fills asset_cache_files from what's already in the folder, oldest first.
+// Entries from earlier runs are ordered by when they were written, since
+// that's all the file system can tell us.
+void asset_cache_scan() {
+	asset_cache_files.clear();
+	asset_cache_size = 0;
+
+#if defined(SK_OS_WINDOWS) || defined(SK_OS_WINDOWS_UWP)
+	char    *filter  = platform_push_path_new(asset_cache_folder, "*.skc");
+	int32_t  wsize   = MultiByteToWideChar(CP_UTF8, 0, filter, -1, nullptr, 0);
+	wchar_t *wfilter = sk_malloc_t(wchar_t, wsize);
+	MultiByteToWideChar(CP_UTF8, 0, filter, -1, wfilter, wsize);
+	sk_free(filter);
+
+	WIN32_FIND_DATAW info;
+	HANDLE           handle = FindFirstFileExW(wfilter, FindExInfoBasic, &info, FindExSearchNameMatch, nullptr, 0);
+	sk_free(wfilter);
+	if (handle != INVALID_HANDLE_VALUE) {
+		do {
+			if (info.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) continue;
+			char     name[64];
+			uint64_t key = 0;
+			if (WideCharToMultiByte(CP_UTF8, 0, info.cFileName, -1, name, sizeof(name), nullptr, nullptr) == 0) continue;
+			if (!asset_cache_parse_name(name, &key)) continue;
+
+			asset_cache_file_t file;
+			file.key  = key;
+			file.size = ((uint64_t)info.nFileSizeHigh << 32) | info.nFileSizeLow;
+			file.used = ((uint64_t)info.ftLastWriteTime.dwHighDateTime << 32) | info.ftLastWriteTime.dwLowDateTime;
+			asset_cache_files.add(file);
+		} while (FindNextFileW(handle, &info));
+		FindClose(handle);
+	}
+#elif defined(SK_OS_LINUX) || defined(SK_OS_ANDROID)
+	DIR *dir = opendir(asset_cache_folder);
+	if (dir != nullptr) {
+		struct dirent *item;
+		while ((item = readdir(dir)) != nullptr) {
+			uint64_t key = 0;
+			if (!asset_cache_parse_name(item->d_name, &key)) continue;
+
+			char       *filename = platform_push_path_new(asset_cache_folder, item->d_name);
+			struct stat info;
+			if (stat(filename, &info) == 0 && S_ISREG(info.st_mode)) {
+				asset_cache_file_t file;
+				file.key  = key;
+				file.size = (uint64_t)info.st_size;
+				file.used = (uint64_t)info.st_mtime;
+				asset_cache_files.add(file);
+			}
+			sk_free(filename);
+		}
+		closedir(dir);
+	}
+#endif
+
+	asset_cache_files.sort([](const asset_cache_file_t &a, const asset_cache_file_t &b) {
+		return (int32_t)((a.used > b.used) - (a.used < b.used)); });
+	asset_cache_stamp = 0;
+	for (int32_t i = 0; i < asset_cache_files.count; i++) {
+		asset_cache_files[i].used = ++asset_cache_stamp;
+		asset_cache_size += asset_cache_files[i].size;
+	}
+}
+
+///////////////////////////////////////////
+
+// Deletes the least recently used entries until the cache fits in its
+// limit. keep_key is an entry that was just written, and stays regardless.
+void asset_cache_evict(uint64_t keep_key) {
+	if (asset_cache_folder == nullptr || asset_cache_limit == 0) return;
+
+	while (asset_cache_size > asset_cache_limit) {
+		int32_t oldest = -1;
+		for (int32_t i = 0; i < asset_cache_files.count; i++) {
+			if (asset_cache_files[i].key == keep_key) continue;
+			if (oldest == -1 || asset_cache_files[i].used < asset_cache_files[oldest].used)
+				oldest = i;
+		}
+		if (oldest == -1) break;
+
+		// Mapped entries are opened with delete sharing, so anything still
+		// reading this one keeps its view of it.
+		char name[64];
+		snprintf(name, sizeof(name), "%016" PRIx64 ".skc", asset_cache_files[oldest].key);
+		char *filename = platform_push_path_new(asset_cache_folder, name);
+		asset_cache_delete_file(filename);
+		sk_free(filename);
+
+		asset_cache_size -= asset_cache_files[oldest].size;
+		asset_cache_files.remove(oldest);
+	}
+}
+
+///////////////////////////////////////////
+
+// Records that an entry was just written or hit, so it's the last to go.
+void asset_cache_touch(uint64_t key, uint64_t size, bool written) {
+	asset_cache_lock();
+	int32_t index = asset_cache_files.index_where(&asset_cache_file_t::key, key);
+	if (index == -1 && written) {
+		index = asset_cache_files.add({ key, 0, 0 });
+	}
+	if (index != -1) {
+		asset_cache_file_t *file = &asset_cache_files[index];
+		if (written) {
+			asset_cache_size = asset_cache_size - file->size + size;
+			file->size       = size;
+		}
+		file->used = ++asset_cache_stamp;
+	}
+	if (written) asset_cache_evict(key);
+	asset_cache_unlock();
+}
+
+///////////////////////////////////////////
+
+void assets_set_cache_folder(const char *folder_utf8) {
+	asset_cache_lock();
+	sk_free(asset_cache_folder);
+	asset_cache_files.clear();
+	asset_cache_size = 0;
+	if (folder_utf8 != nullptr && folder_utf8[0] != '\0') {
+		asset_cache_folder = string_copy(folder_utf8);
+		asset_cache_make_folder(asset_cache_folder);
+		asset_cache_scan ();
+		asset_cache_evict(0);
+	}
+	asset_cache_unlock();
+}
+
+///////////////////////////////////////////
+
+const char *assets_get_cache_folder() {
+	return asset_cache_folder;
+}
+
+///////////////////////////////////////////
+
+void assets_set_cache_limit(uint64_t max_bytes) {
+	asset_cache_lock();
+	asset_cache_limit = max_bytes;
+	asset_cache_evict(0);
+	asset_cache_unlock();
+}
+
+///////////////////////////////////////////
+
+uint64_t assets_get_cache_limit() {
+	return asset_cache_limit;
+}
+
+///////////////////////////////////////////
+
+void asset_cache_init() {
+	if (asset_cache_mtx == nullptr) asset_cache_mtx = ft_mutex_create();
+}
+
+///////////////////////////////////////////
+
+void asset_cache_shutdown() {
+	sk_free(asset_cache_folder);
+	asset_cache_files.free();
+	asset_cache_size  = 0;
+	asset_cache_limit = asset_cache_limit_default;
+	if (asset_cache_mtx != nullptr) ft_mutex_destroy(&asset_cache_mtx);
+}
+
+///////////////////////////////////////////
+
+bool32_t asset_cache_enabled() {
+	asset_cache_lock();
+	bool32_t result = asset_cache_folder != nullptr;
+	asset_cache_unlock();
+	return result;
+}
+
+///////////////////////////////////////////
+
+uint64_t asset_cache_hash(const void *data, size_t size, uint64_t start_hash) {
+	return hash_fnv64_data(data, size, start_hash);
+}
+
+///////////////////////////////////////////
+
+uint64_t asset_cache_build() {
+	return hash_fnv64_string(asset_cache_backend, hash_fnv64_string(sk_version_name()));
+}
+
+///////////////////////////////////////////
+
+// Returns null if the cache was turned off in the meantime.
+char *asset_cache_path(uint64_t key, const char *suffix) {
+	char name[64];
+	snprintf(name, sizeof(name), "%016" PRIx64 ".skc%s", key, suffix);
+	asset_cache_lock();
+	char *result = asset_cache_folder == nullptr
+		? nullptr
+		: platform_push_path_new(asset_cache_folder, name);
+	asset_cache_unlock();
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool asset_cache_map(asset_cache_t *cache, const char *filename) {
+#if defined(SK_OS_WINDOWS)
+	int32_t  wsize     = MultiByteToWideChar(CP_UTF8, 0, filename, -1, nullptr, 0);
+	wchar_t *wfilename = sk_malloc_t(wchar_t, wsize);
+	MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename, wsize);
+	cache->file = CreateFileW(wfilename, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	sk_free(wfilename);
+	if (cache->file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(cache->file, &size) || size.QuadPart == 0) {
+		CloseHandle(cache->file);
+		return false;
+	}
+	cache->mapping = CreateFileMappingW(cache->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (cache->mapping == nullptr) {
+		CloseHandle(cache->file);
+		return false;
+	}
+	cache->data = (const uint8_t *)MapViewOfFile(cache->mapping, FILE_MAP_READ, 0, 0, 0);
+	if (cache->data == nullptr) {
+		CloseHandle(cache->mapping);
+		CloseHandle(cache->file);
+		return false;
+	}
+	cache->size   = (uint64_t)size.QuadPart;
+	cache->mapped = true;
+	return true;
+#elif defined(SK_ASSET_CACHE_MMAP)
+	int fd = open(filename, O_RDONLY);
+	if (fd == -1)
+		return false;
+
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size == 0) {
+		close(fd);
+		return false;
+	}
+	void *data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return false;
+
+	cache->data   = (const uint8_t *)data;
+	cache->size   = (uint64_t)info.st_size;
+	cache->mapped = true;
+	return true;
+#else
+	// No file mapping here, so read it into memory instead.
+	void  *data = nullptr;
+	size_t size = 0;
+	if (!platform_read_file(filename, &data, &size))
+		return false;
+	cache->data   = (const uint8_t *)data;
+	cache->size   = size;
+	cache->mapped = false;
+	return true;
+#endif
+}
+
+///////////////////////////////////////////
+
+void asset_cache_unmap(asset_cache_t *cache) {
+	if (cache->data == nullptr) return;
+	if (cache->mapped) {
+#if defined(SK_OS_WINDOWS)
+		UnmapViewOfFile(cache->data);
+		CloseHandle(cache->mapping);
+		CloseHandle(cache->file);
+#elif defined(SK_ASSET_CACHE_MMAP)
+		munmap((void *)cache->data, (size_t)cache->size);
+#endif
+	} else {
+		void *data = (void *)cache->data;
+		sk_free(data);
+	}
+	cache->data = nullptr;
+}
+
+///////////////////////////////////////////
+
+asset_cache_t *asset_cache_open(uint64_t key, uint64_t content_hash) {
+	if (!asset_cache_enabled()) return nullptr;
+
+	char *filename = asset_cache_path(key, "");
+	if (filename == nullptr) return nullptr;
+
+	asset_cache_t *result = sk_calloc_t(asset_cache_t, 1);
+	bool           found  = asset_cache_map(result, filename);
+	sk_free(filename);
+	if (!found) {
+		sk_free(result);
+		return nullptr;
+	}
+
+	// Anything that doesn't line up is just a miss, the caller will write
+	// a fresh entry over it.
+	const asset_cache_header_t *header = (const asset_cache_header_t *)result->data;
+	bool valid = result->size >= sizeof(asset_cache_header_t)
+		&& memcmp(header->magic, asset_cache_magic, sizeof(asset_cache_magic)) == 0
+		&& header->version      == asset_cache_version
+		&& header->build        == asset_cache_build()
+		&& header->key          == key
+		&& header->content_hash == content_hash
+		&& result->size >= sizeof(asset_cache_header_t) + header->section_count * sizeof(asset_cache_entry_t);
+	if (valid) {
+		result->sections      = (const asset_cache_entry_t *)(result->data + sizeof(asset_cache_header_t));
+		result->section_count = header->section_count;
+		for (uint32_t i = 0; i < result->section_count && valid; i++) {
+			const asset_cache_entry_t *section = &result->sections[i];
+			valid = section->offset <= result->size && section->size <= result->size - section->offset;
+		}
+	}
+	if (!valid) {
+		asset_cache_close(result);
+		return nullptr;
+	}
+	asset_cache_touch(key, result->size, false);
+	return result;
+}
+
+///////////////////////////////////////////
+
+void asset_cache_close(asset_cache_t *cache) {
+	if (cache == nullptr) return;
+	asset_cache_unmap(cache);
+	sk_free(cache);
+}
+
+///////////////////////////////////////////
+
+// The index'th section with this tag, in the order they were written.
+const void *asset_cache_get(const asset_cache_t *cache, uint32_t tag, int32_t index, uint64_t *out_size) {
+	for (uint32_t i = 0; i < cache->section_count; i++) {
+		if (cache->sections[i].tag != tag) continue;
+		if (index > 0) { index--; continue; }
+
+		if (out_size != nullptr) *out_size = cache->sections[i].size;
+		return cache->data + cache->sections[i].offset;
+	}
+	if (out_size != nullptr) *out_size = 0;
+	return nullptr;
+}
+
+///////////////////////////////////////////
+
+int32_t asset_cache_count(const asset_cache_t *cache, uint32_t tag) {
+	int32_t result = 0;
+	for (uint32_t i = 0; i < cache->section_count; i++) {
+		if (cache->sections[i].tag == tag) result++;
+	}
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool32_t asset_cache_write(uint64_t key, uint64_t content_hash, const asset_cache_section_t *sections, int32_t section_count) {
+	if (!asset_cache_enabled()) return false;
+
+	asset_cache_header_t header = {};
+	memcpy(header.magic, asset_cache_magic, sizeof(asset_cache_magic));
+	header.version       = asset_cache_version;
+	header.build         = asset_cache_build();
+	header.key           = key;
+	header.content_hash  = content_hash;
+	header.section_count = (uint32_t)section_count;
+
+	// Section data is aligned, so mapped vertex and pixel data can be used
+	// right where it sits.
+	asset_cache_entry_t *entries = sk_malloc_t(asset_cache_entry_t, section_count);
+	uint64_t             offset  = sizeof(asset_cache_header_t) + sizeof(asset_cache_entry_t) * section_count;
+	for (int32_t i = 0; i < section_count; i++) {
+		offset = (offset + asset_cache_alignment - 1) & ~(asset_cache_alignment - 1);
+		entries[i] = { sections[i].tag, 0, offset, sections[i].size };
+		offset += sections[i].size;
+	}
+
+	// Write to a temporary file, then move it into place, so nobody ever
+	// opens a half written entry.
+	char suffix[32];
+	snprintf(suffix, sizeof(suffix), ".%d.tmp", atomic_increment(&asset_cache_write_count));
+	char *tmp_filename = asset_cache_path(key, suffix);
+	char *filename     = asset_cache_path(key, "");
+	if (tmp_filename == nullptr || filename == nullptr) {
+		sk_free(entries);
+		sk_free(tmp_filename);
+		sk_free(filename);
+		return false;
+	}
+
+#if defined(SK_OS_WINDOWS) || defined(SK_OS_WINDOWS_UWP)
+	int32_t  wsize         = MultiByteToWideChar(CP_UTF8, 0, tmp_filename, -1, nullptr, 0);
+	wchar_t *wtmp_filename = sk_malloc_t(wchar_t, wsize);
+	MultiByteToWideChar(CP_UTF8, 0, tmp_filename, -1, wtmp_filename, wsize);
+	FILE *fp = _wfopen(wtmp_filename, L"wb");
+#else
+	FILE *fp = fopen(tmp_filename, "wb");
+#endif
+
+	bool result = fp != nullptr;
+	if (result) {
+		const uint8_t zeros[asset_cache_alignment] = {};
+		uint64_t      at                           = sizeof(header) + sizeof(asset_cache_entry_t) * section_count;
+		result = fwrite(&header, sizeof(header), 1, fp) == 1;
+		if (result && section_count > 0)
+			result = fwrite(entries, sizeof(asset_cache_entry_t), section_count, fp) == (size_t)section_count;
+		for (int32_t i = 0; i < section_count && result; i++) {
+			if (entries[i].offset > at)
+				result = fwrite(zeros, (size_t)(entries[i].offset - at), 1, fp) == 1;
+			if (result && sections[i].size > 0)
+				result = fwrite(sections[i].data, (size_t)sections[i].size, 1, fp) == 1;
+			at = entries[i].offset + sections[i].size;
+		}
+		result = fclose(fp) == 0 && result;
+	}
+
+#if defined(SK_OS_WINDOWS) || defined(SK_OS_WINDOWS_UWP)
+	if (result) {
+		wsize = MultiByteToWideChar(CP_UTF8, 0, filename, -1, nullptr, 0);
+		wchar_t *wfilename = sk_malloc_t(wchar_t, wsize);
+		MultiByteToWideChar(CP_UTF8, 0, filename, -1, wfilename, wsize);
+		result = MoveFileExW(wtmp_filename, wfilename, MOVEFILE_REPLACE_EXISTING) != 0;
+		sk_free(wfilename);
+	}
+	if (!result && fp != nullptr) _wremove(wtmp_filename);
+	sk_free(wtmp_filename);
+#else
+	if (result)
+		result = rename(tmp_filename, filename) == 0;
+	if (!result && fp != nullptr) remove(tmp_filename);
+#endif
+
+	if (!result) log_diagf("Couldn't write asset cache entry %s", filename);
+	else         asset_cache_touch(key, offset, true);
+
+	sk_free(entries);
+	sk_free(tmp_filename);
+	sk_free(filename);
+	return result;
+}
+
+} // namespace sk
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../stereokit.h"
+
+namespace sk {
+
+///////////////////////////////////////////
+// Asset cache                           //
+///////////////////////////////////////////
+
+// An opt-in folder of preprocessed asset data, so things like decoded
+// images don't need decoding again on the next launch. Each entry is one
+// file, named after a key the caller builds from the source's path and
+// load options. The entry also stores a hash of the source's contents, so
+// a changed source just misses, and gets written over. Entries are a list
+// of tagged sections, mapped into memory when the platform allows it.
+
+struct asset_cache_t;
+
+struct asset_cache_section_t {
+	uint32_t    tag;
+	const void *data;
+	uint64_t    size;
+};
+
+#define asset_cache_tag(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+bool32_t       asset_cache_enabled ();
+uint64_t       asset_cache_hash    (const void *data, size_t size, uint64_t start_hash);
+asset_cache_t *asset_cache_open    (uint64_t key, uint64_t content_hash);
+void           asset_cache_close   (asset_cache_t *cache);
+const void    *asset_cache_get     (const asset_cache_t *cache, uint32_t tag, int32_t index, uint64_t *out_size);
+int32_t        asset_cache_count   (const asset_cache_t *cache, uint32_t tag);
+bool32_t       asset_cache_write   (uint64_t key, uint64_t content_hash, const asset_cache_section_t *sections, int32_t section_count);
+void           asset_cache_init    ();
+void           asset_cache_shutdown();
+
+} // namespace sk
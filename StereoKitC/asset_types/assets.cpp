@@ -1,4 +1,6 @@
 #include "assets.h"
+#include "assets_index.h"
+#include "asset_cache.h"
 #include "../_stereokit.h"
 #include "../sk_memory.h"
 
@@ -35,34 +37,72 @@ struct asset_load_callback_t {
 struct asset_thread_t {
 	ft_id_t  id;
 	bool32_t running;
+	int32_t  queue;
+};
+
+// Each asset thread has its own queue, so threads mostly don't contend with
+// each other. Tasks a thread is partway through go in resume, and get
+// picked up again before anything new. Everything else waits in a binary
+// heap, lowest sort first, which within a priority means the cheapest
+// task first. New tasks go to the queue with the least work in it, and a
+// thread with nothing in its own queue steals from the busiest one.
+struct asset_queue_t {
+	ft_mutex_t             mtx;
+	array_t<asset_task_t*> resume;
+	array_t<asset_task_t*> heap;
+	int64_t                cost; // Total complexity of everything in the queue
+};
+
+// How many unfinished tasks there are at each priority, sorted by priority.
+struct asset_priority_count_t {
+	int32_t priority;
+	int32_t count;
 };
 
 ///////////////////////////////////////////
 
 array_t<asset_header_t *>      assets = {};
+asset_index_t                  assets_index = {};
+ft_mutex_t                     assets_index_lock = {};
 array_t<asset_header_t *>      assets_multithread_destroy = {};
+array_t<asset_header_t *>      assets_multithread_destroy_now = {};
 ft_mutex_t                     assets_multithread_destroy_lock = {};
+array_t<asset_header_t *>      assets_frame_destroy = {};
+array_t<asset_header_t *>      assets_frame_destroy_now = {};
+uint64_t                       assets_frame_epoch = 1;
 ft_id_t                        assets_gpu_thread = {};
 ft_mutex_t                     assets_job_lock = {};
 array_t<asset_job_t *>         assets_gpu_jobs = {};
 ft_mutex_t                     assets_load_event_lock = {};
 array_t<asset_load_callback_t> assets_load_callbacks = {};
 array_t<asset_header_t *>      assets_load_events = {};
+float                          assets_upload_budget_ms = 4;
+asset_upload_stats_t           assets_upload_stats = {};
 
 ///////////////////////////////////////////
 
-array_t<asset_thread_t>asset_threads         = {};
-bool32_t               asset_thread_enabled  = false;
-array_t<asset_task_t*> asset_thread_tasks    = {};
-ft_mutex_t             asset_thread_task_mtx = {};
-int32_t                asset_tasks_finished  = 0;
-int32_t                asset_tasks_processing= 0;
-int32_t                asset_tasks_priority  = INT_MAX;
-ft_condition_t         asset_tasks_available = {};
-array_t<asset_task_t*> asset_active_tasks    = {};
-
-int32_t asset_thread   (void *);
-void    asset_step_task();
+array_t<asset_thread_t>         asset_threads         = {};
+bool32_t                        asset_thread_enabled  = false;
+array_t<asset_queue_t>          asset_queues          = {};
+uint32_t                        asset_queue_next      = 0;
+uint64_t                        asset_task_order      = 0;
+ft_mutex_t                      asset_thread_task_mtx = {};
+array_t<asset_priority_count_t> asset_task_priorities = {};
+int32_t                         asset_tasks_finished  = 0;
+int32_t                         asset_tasks_processing= 0;
+int32_t                         asset_tasks_priority  = INT_MAX;
+int32_t                         asset_tasks_queued    = 0;
+ft_mutex_t                      asset_tasks_sleep_mtx = {};
+ft_condition_t                  asset_tasks_available = {};
+asset_task_timing_t             asset_task_timings[64]= {};
+int32_t                         asset_task_timing_total = 0;
+
+int32_t asset_thread      (void *);
+bool    asset_step_task     (int32_t queue_idx);
+void    assets_step_gpu_jobs();
+void    assets_queue_task   (asset_task_t *task);
+void    assets_resume_task  (asset_task_t *task);
+void    assets_destroy_deferred(asset_header_t *asset);
 
 ///////////////////////////////////////////
 
@@ -73,12 +113,23 @@ void *assets_find(const char *id, asset_type_ type) {
 ///////////////////////////////////////////
 
 void *assets_find(uint64_t id, asset_type_ type) {
-	int32_t count = assets.count;
-	for (int32_t i = 0; i < count; i++) {
-		if (assets[i]->id == id && assets[i]->type == type && assets[i]->refs > 0)
-			return assets[i];
-	}
-	return nullptr;
+	ft_mutex_lock(assets_index_lock);
+	asset_header_t *result = asset_index_find(&assets_index, id, type);
+	ft_mutex_unlock(assets_index_lock);
+	return result;
+}
+
+///////////////////////////////////////////
+
+void *assets_find_ref(const char *id, asset_type_ type) {
+	// The reference is added under the same lock assets_destroy uses to
+	// pull an asset from the index, so an asset can't be found on one
+	// thread while it's being destroyed on another.
+	ft_mutex_lock(assets_index_lock);
+	asset_header_t *result = asset_index_find(&assets_index, hash_fnv64_string(id), type);
+	if (result != nullptr) assets_addref(result);
+	ft_mutex_unlock(assets_index_lock);
+	return result;
 }
 
 ///////////////////////////////////////////
@@ -123,6 +174,10 @@ void *assets_allocate(asset_type_ type) {
 	header->state   = asset_state_none;
 	assets_addref(header);
 	assets.add(header);
+
+	ft_mutex_lock(assets_index_lock);
+	asset_index_add(&assets_index, header);
+	ft_mutex_unlock(assets_index_lock);
 	return header;
 }
 
@@ -144,7 +199,11 @@ void assets_set_id(asset_header_t *header, uint64_t id) {
 	}
 	assert(other == nullptr);
 #endif
+	ft_mutex_lock(assets_index_lock);
+	asset_index_remove(&assets_index, header);
 	header->id = id;
+	asset_index_add(&assets_index, header);
+	ft_mutex_unlock(assets_index_lock);
 }
 
 ///////////////////////////////////////////
@@ -158,7 +217,7 @@ void assets_addref(asset_header_t *asset) {
 void assets_releaseref(asset_header_t *asset) {
 	// Manage the reference count
 	if (atomic_decrement(&asset->refs) == 0) {
-		assets_destroy(asset);
+		assets_destroy_deferred(asset);
 	} else if (asset->refs < 0) {
 		log_errf("Released too many references to asset[%d]%s%s",
 			asset->type, 
@@ -193,12 +252,19 @@ void assets_releaseref_threadsafe(void *asset) {
 ///////////////////////////////////////////
 
 void assets_destroy(asset_header_t *asset) {
+	// Finding an asset adds its reference under the index lock, so checking
+	// the count and dropping it from the index under that same lock means
+	// nothing can pick up a new reference once we've committed to this.
+	ft_mutex_lock(assets_index_lock);
 	if (asset->refs != 0) {
 		// If something else picked up a reference to this between submission
 		// for destruction and now, that's actually just fine! We can just
 		// break out of here.
+		ft_mutex_unlock(assets_index_lock);
 		return;
 	}
+	asset_index_remove(&assets_index, asset);
+	ft_mutex_unlock(assets_index_lock);
 
 	// destroy functions will often zero out their contents for safety, so we
 	// need to free the id text first
@@ -232,6 +298,58 @@ void assets_destroy(asset_header_t *asset) {
 
 ///////////////////////////////////////////
 
+void assets_destroy_deferred(asset_header_t *asset) {
+	// Render lists that only live for a frame don't hold references to the
+	// meshes and materials they draw, so those have to stick around until
+	// the lists are done with them. Anything released this frame may still
+	// be in a list recorded on another thread for the next frame, so they
+	// wait a full frame before getting destroyed.
+	if (asset->type != asset_type_mesh && asset->type != asset_type_material) {
+		assets_destroy(asset);
+		return;
+	}
+
+	ft_mutex_lock(assets_multithread_destroy_lock);
+	if (asset->destroy_frame == 0)
+		assets_frame_destroy.add(asset);
+	asset->destroy_frame = assets_frame_epoch;
+	ft_mutex_unlock(assets_multithread_destroy_lock);
+}
+
+///////////////////////////////////////////
+
+void assets_frame_end(bool32_t destroy_all) {
+	// Pull out everything that's due first, destroying assets can release
+	// others, which will land back in assets_frame_destroy.
+	ft_mutex_lock(assets_multithread_destroy_lock);
+	for (int32_t i = assets_frame_destroy.count - 1; i >= 0; i--) {
+		asset_header_t *asset = assets_frame_destroy[i];
+		if (atomic_read(&asset->refs) > 0) {
+			// Something picked up a new reference in the meantime, and if
+			// one shows up after this check, assets_destroy catches it
+			asset->destroy_frame = 0;
+			assets_frame_destroy.remove(i);
+		} else if (destroy_all || asset->destroy_frame < assets_frame_epoch) {
+			asset->destroy_frame = 0;
+			assets_frame_destroy_now.add(asset);
+			assets_frame_destroy.remove(i);
+		}
+	}
+	assets_frame_epoch += 1;
+	ft_mutex_unlock(assets_multithread_destroy_lock);
+
+	for (int32_t i = 0; i < assets_frame_destroy_now.count; i++) {
+		assets_destroy(assets_frame_destroy_now[i]);
+	}
+	assets_frame_destroy_now.clear();
+
+	// Releasing everything can cascade, so keep going until it settles.
+	if (destroy_all && assets_frame_destroy.count > 0)
+		assets_frame_end(destroy_all);
+}
+
+///////////////////////////////////////////
+
 void assets_safeswap_ref(asset_header_t **asset_link, asset_header_t *asset) {
 	// Swap references by adding a reference first, then removing. If the asset
 	// is the same, then this prevents the asset from getting destroyed.
@@ -333,17 +451,37 @@ bool assets_init() {
 	assets_multithread_destroy_lock = ft_mutex_create();
 	assets_job_lock                 = ft_mutex_create();
 	asset_thread_task_mtx           = ft_mutex_create();
+	asset_tasks_sleep_mtx           = ft_mutex_create();
 	assets_load_event_lock          = ft_mutex_create();
+	assets_index_lock               = ft_mutex_create();
 	asset_tasks_available           = ft_condition_create();
+	asset_cache_init();
 
+	// Leave a core for the main thread, but keep at least the 3 threads
+	// we've always had, and don't go overboard on big machines.
+	int32_t thread_count = 0;
 #if !defined(__EMSCRIPTEN__)
-	asset_threads.resize(3);
+	thread_count = ft_processor_count() - 1;
+	if (thread_count < 3) thread_count = 3;
+	if (thread_count > 8) thread_count = 8;
 #endif
+
+	// With no threads, assets_step still works through queue 0.
+	int32_t queue_count = thread_count > 0 ? thread_count : 1;
+	asset_queues.resize(queue_count);
+	for (int32_t i = 0; i < queue_count; i++) {
+		asset_queue_t queue = {};
+		queue.mtx = ft_mutex_create();
+		asset_queues.add(queue);
+	}
+
+	asset_threads.resize(thread_count);
 	asset_thread_enabled = true;
-	for (int32_t i = 0; i < asset_threads.capacity; i++)
+	for (int32_t i = 0; i < thread_count; i++)
 	{
 		asset_threads.add({});
 		asset_thread_t* th = &asset_threads.last();
+		th->queue = i;
 		ft_thread_create(asset_thread, th);
 	}
 
@@ -357,25 +495,24 @@ void assets_step() {
 	// If we have no asset threads for some reason (like WASM), then we'll need
 	// to make sure assets still get loaded here!
 	if (asset_threads.count <= 0) {
-		asset_step_task();
+		asset_step_task(0);
 	}
 
-	// destroy objects where the request came from another thread
+	// destroy objects where the request came from another thread. Destroying
+	// takes assets_multithread_destroy_lock again for meshes and materials,
+	// and through anything a destroyed asset releases, so the list is
+	// swapped out first and processed without the lock.
 	ft_mutex_lock(assets_multithread_destroy_lock);
-	for (int32_t i = 0; i < assets_multithread_destroy.count; i++) {
-		assets_destroy(assets_multithread_destroy[i]);
-	}
-	assets_multithread_destroy.clear();
+	array_t<asset_header_t *> pending = assets_multithread_destroy;
+	assets_multithread_destroy     = assets_multithread_destroy_now;
+	assets_multithread_destroy_now = pending;
 	ft_mutex_unlock(assets_multithread_destroy_lock);
-
-	// Do any jobs the assets need on the main thread, like GPU buffer uploads
-	ft_mutex_lock(assets_job_lock);
-	for (int32_t i = 0; i < assets_gpu_jobs.count; i++) {
-		assets_gpu_jobs[i]->success  = assets_gpu_jobs[i]->asset_job(assets_gpu_jobs[i]->data);
-		assets_gpu_jobs[i]->finished = true;
+	for (int32_t i = 0; i < assets_multithread_destroy_now.count; i++) {
+		assets_destroy_deferred(assets_multithread_destroy_now[i]);
 	}
-	assets_gpu_jobs.clear();
-	ft_mutex_unlock(assets_job_lock);
+	assets_multithread_destroy_now.clear();
+
+	assets_step_gpu_jobs();
 
 	// Update any on_load event callbacks
 	ft_mutex_lock(assets_load_event_lock);
@@ -404,9 +541,96 @@ void assets_step() {
 
 ///////////////////////////////////////////
 
+// Blocking jobs from assets_execute_gpu have a thread waiting on them, so
+// they go first, then task jobs in the same order the task queues use.
+int32_t assets_gpu_job_compare(asset_job_t *const &a, asset_job_t *const &b) {
+	if (a->task == nullptr || b->task == nullptr)
+		return (a->task != nullptr) - (b->task != nullptr);
+	if (a->task->sort != b->task->sort) return a->task->sort < b->task->sort ? -1 : 1;
+	return a->task->order < b->task->order ? -1 : 1;
+}
+
+///////////////////////////////////////////
+
+// Do any jobs the assets need on the main thread, like GPU buffer uploads.
+// A burst of uploads can take far longer than a frame, so this stops once
+// the budget is spent and leaves the rest for later. At least one job
+// always runs, so nothing starves, but one big enough job will still blow
+// the budget, and that gets counted as a hitch.
+void assets_step_gpu_jobs() {
+	ft_mutex_lock(assets_job_lock);
+	if (assets_gpu_jobs.count == 0) {
+		assets_upload_stats.pending  = 0;
+		assets_upload_stats.uploaded = 0;
+		assets_upload_stats.last_ms  = 0;
+		ft_mutex_unlock(assets_job_lock);
+		return;
+	}
+
+	// The qsort underneath isn't stable, but blocking jobs come from
+	// different threads anyhow, and task jobs never tie.
+	assets_gpu_jobs.sort(assets_gpu_job_compare);
+
+	uint64_t step_start = stm_now();
+	int32_t  ran        = 0;
+	while (ran < assets_gpu_jobs.count) {
+		if (ran > 0 && assets_upload_budget_ms > 0 && stm_ms(stm_since(step_start)) >= assets_upload_budget_ms)
+			break;
+
+		asset_job_t  *job   = assets_gpu_jobs[ran];
+		asset_task_t *task  = job->task;
+		uint64_t      start = stm_now();
+		job->success  = job->asset_job(job->data);
+		if (task != nullptr) task->time_gpu += stm_since(start);
+		job->finished = true;
+		// Tasks sit outside the queues while their GPU job waits, so no
+		// asset thread has to keep checking on them.
+		if (task != nullptr) assets_resume_task(task);
+		ran += 1;
+	}
+	for (int32_t i = ran; i < assets_gpu_jobs.count; i++)
+		assets_gpu_jobs[i - ran] = assets_gpu_jobs[i];
+	assets_gpu_jobs.count -= ran;
+
+	float step_ms = (float)stm_ms(stm_since(step_start));
+	assets_upload_stats.pending         = assets_gpu_jobs.count;
+	assets_upload_stats.uploaded        = ran;
+	assets_upload_stats.last_ms         = step_ms;
+	assets_upload_stats.total_uploaded += ran;
+	if (step_ms > assets_upload_stats.max_ms)                             assets_upload_stats.max_ms          = step_ms;
+	if (assets_gpu_jobs.count > 0)                                        assets_upload_stats.deferred_steps += 1;
+	if (assets_upload_budget_ms > 0 && step_ms > assets_upload_budget_ms) assets_upload_stats.hitch_steps    += 1;
+	ft_mutex_unlock(assets_job_lock);
+}
+
+///////////////////////////////////////////
+
+void assets_set_upload_budget(float budget_ms) {
+	assets_upload_budget_ms = budget_ms;
+}
+
+///////////////////////////////////////////
+
+float assets_get_upload_budget() {
+	return assets_upload_budget_ms;
+}
+
+///////////////////////////////////////////
+
+asset_upload_stats_t assets_get_upload_stats() {
+	ft_mutex_lock(assets_job_lock);
+	asset_upload_stats_t result = assets_upload_stats;
+	ft_mutex_unlock(assets_job_lock);
+	return result;
+}
+
+///////////////////////////////////////////
+
 void assets_shutdown() {
+	ft_mutex_lock(asset_tasks_sleep_mtx);
 	asset_thread_enabled = false;
 	ft_condition_broadcast(asset_tasks_available);
+	ft_mutex_unlock(asset_tasks_sleep_mtx);
 	for (int32_t i = 0; i < asset_threads.count; i++) {
 		while (asset_threads[i].running) {
 			assets_step();
@@ -414,16 +638,26 @@ void assets_shutdown() {
 		}
 	}
 	asset_threads.free();
+	assets_frame_end(true);
 
 #if defined(SK_DEBUG_MEM)
 	assets_shutdown_check();
 #endif
 
 	ft_mutex_destroy(&asset_thread_task_mtx);
-	asset_thread_tasks.free();
-	asset_active_tasks.free();
+	ft_mutex_destroy(&asset_tasks_sleep_mtx);
+	for (int32_t i = 0; i < asset_queues.count; i++) {
+		ft_mutex_destroy(&asset_queues[i].mtx);
+		asset_queues[i].resume.free();
+		asset_queues[i].heap  .free();
+	}
+	asset_queues         .free();
+	asset_task_priorities.free();
 
 	assets_multithread_destroy.free();
+	assets_multithread_destroy_now.free();
+	assets_frame_destroy      .free();
+	assets_frame_destroy_now  .free();
 	assets_gpu_jobs           .free();
 	ft_mutex_destroy(&assets_multithread_destroy_lock);
 	ft_mutex_destroy(&assets_job_lock);
@@ -434,10 +668,18 @@ void assets_shutdown() {
 	assets_load_callbacks.free();
 	assets_load_events   .free();
 	assets               .free();
+	assets_index         .free();
+	ft_mutex_destroy(&assets_index_lock);
+	asset_cache_shutdown();
 
 	asset_tasks_processing = 0;
 	asset_tasks_finished   = 0;
 	asset_tasks_priority   = INT_MAX;
+	asset_tasks_queued     = 0;
+	asset_queue_next       = 0;
+	asset_task_order       = 0;
+	asset_task_timing_total= 0;
+	assets_upload_stats    = {};
 }
 
 ///////////////////////////////////////////
@@ -550,98 +792,198 @@ void asset_release(asset_t asset) {
 // Asset thread                          //
 ///////////////////////////////////////////
 
+bool assets_task_before(const asset_task_t *a, const asset_task_t *b) {
+	return a->sort != b->sort
+		? a->sort  < b->sort
+		: a->order < b->order;
+}
+
+///////////////////////////////////////////
+
+void assets_heap_push(array_t<asset_task_t*> *heap, asset_task_t *task) {
+	array_t<asset_task_t*> &h = *heap;
+	int32_t at = h.add(task);
+	while (at > 0) {
+		int32_t parent = (at - 1) / 2;
+		if (!assets_task_before(h[at], h[parent])) break;
+		asset_task_t *tmp = h[at];
+		h[at]     = h[parent];
+		h[parent] = tmp;
+		at = parent;
+	}
+}
+
+///////////////////////////////////////////
+
+asset_task_t *assets_heap_pop(array_t<asset_task_t*> *heap) {
+	array_t<asset_task_t*> &h = *heap;
+	if (h.count == 0) return nullptr;
+
+	asset_task_t *result = h[0];
+	h[0] = h.last();
+	h.pop();
+
+	int32_t at = 0;
+	while (true) {
+		int32_t left  = at * 2 + 1;
+		int32_t right = left + 1;
+		int32_t best  = at;
+		if (left  < h.count && assets_task_before(h[left ], h[best])) best = left;
+		if (right < h.count && assets_task_before(h[right], h[best])) best = right;
+		if (best == at) break;
+		asset_task_t *tmp = h[at];
+		h[at]   = h[best];
+		h[best] = tmp;
+		at = best;
+	}
+	return result;
+}
+
+///////////////////////////////////////////
+
+void assets_wake_thread() {
+	atomic_increment(&asset_tasks_queued);
+	ft_mutex_lock(asset_tasks_sleep_mtx);
+	ft_condition_signal(asset_tasks_available);
+	ft_mutex_unlock(asset_tasks_sleep_mtx);
+}
+
+///////////////////////////////////////////
+
+// Unfinished tasks are tracked by priority here, rather than by searching
+// every queue, so assets_current_task_priority stays cheap. Callers hold
+// asset_thread_task_mtx.
+void assets_priority_change(int32_t priority, int32_t delta) {
+	int32_t at = 0;
+	while (at < asset_task_priorities.count && asset_task_priorities[at].priority < priority) at++;
+
+	if (at < asset_task_priorities.count && asset_task_priorities[at].priority == priority) {
+		asset_task_priorities[at].count += delta;
+		if (asset_task_priorities[at].count <= 0)
+			asset_task_priorities.remove(at);
+	} else if (delta > 0) {
+		asset_task_priorities.insert(at, { priority, delta });
+	}
+	asset_tasks_priority = asset_task_priorities.count > 0
+		? asset_task_priorities[0].priority
+		: INT_MAX;
+}
+
+///////////////////////////////////////////
+
 void assets_add_task(asset_task_t src_task) {
 	asset_task_t *task = sk_malloc_t(asset_task_t, 1);
 	memcpy(task, &src_task, sizeof(asset_task_t));
 	assets_addref(task->asset);
 
-	ft_mutex_lock(asset_thread_task_mtx);
+	task->time_added = stm_now();
 
-	// This array_t function has some strange behavior on 32 bit builds related
-	// to render sort items. We're duplicating it here without templating to
-	// avoid the issue for now.
-	int32_t idx = -1;
-	int32_t l = 0, r = asset_thread_tasks.count - 1;
-	while (l <= r) {
-		int32_t mid     = (l + r) / 2;
-		int64_t mid_val = asset_thread_tasks[mid]->sort;
-		if      (mid_val < task->sort) l = mid + 1;
-		else if (mid_val > task->sort) r = mid - 1;
-		else { idx = mid; break; };
-	}
-	if (idx == -1)
-		idx = r < 0 ? r : -(r + 2);
-
-	if (idx < 0) idx = ~idx;
-	asset_thread_tasks.insert(idx, task);
+	ft_mutex_lock(asset_thread_task_mtx);
+	task->order = asset_task_order++;
 	asset_tasks_processing += 1;
+	assets_priority_change(task->priority, 1);
 	ft_mutex_unlock(asset_thread_task_mtx);
 
-	if (asset_thread_tasks.count > 1) ft_condition_broadcast(asset_tasks_available);
-	else                              ft_condition_signal   (asset_tasks_available);
+	assets_queue_task(task);
 }
 
 ///////////////////////////////////////////
 
-int32_t assets_calculate_current_priority() {
-	int32_t result = INT_MAX;
-	for (int32_t i = 0; i < asset_active_tasks.count; i++) {
-		if (result > asset_active_tasks[i]->priority)
-			result = asset_active_tasks[i]->priority;
+// Puts a task in the heap of whichever queue has the least work waiting.
+// Costs are read without locking, so they're only a hint, which is all
+// balancing needs.
+void assets_queue_task(asset_task_t *task) {
+	int32_t start = (int32_t)((uint32_t)atomic_increment(&asset_queue_next) % (uint32_t)asset_queues.count);
+	int32_t best  = start;
+	for (int32_t i = 1; i < asset_queues.count; i++) {
+		int32_t idx = (start + i) % asset_queues.count;
+		if (asset_queues[idx].cost < asset_queues[best].cost) best = idx;
 	}
-	if (asset_thread_tasks.count > 0 && result > asset_thread_tasks[0]->priority) {
-		result = asset_thread_tasks[0]->priority;
-	}
-	return result;
+
+	task->worker = best;
+	asset_queue_t *queue = &asset_queues[best];
+	ft_mutex_lock(queue->mtx);
+	assets_heap_push(&queue->heap, task);
+	queue->cost += task->complexity;
+	ft_mutex_unlock(queue->mtx);
+
+	assets_wake_thread();
 }
 
 ///////////////////////////////////////////
 
-asset_task_t* assets_acquire_task() {
-	// Pop out the task we want to work on
-	ft_mutex_lock(asset_thread_task_mtx);
-	if (asset_thread_tasks.count <= 0) { ft_mutex_unlock(asset_thread_task_mtx); return nullptr; }
-	asset_task_t* result = nullptr;
-
-	// Find a task that's ready for work
-	for (int32_t i = 0; i < asset_thread_tasks.count; i++) {
-		asset_task_t*        task   = asset_thread_tasks[i];
-		asset_load_action_t* action = &task->actions[task->action_curr];
-		if (action->thread_affinity != asset_thread_gpu || task->gpu_started == false || task->gpu_job.finished) {
-			result = task;
-			asset_thread_tasks.remove(i);
-			asset_active_tasks.add(result);
-			asset_tasks_priority = assets_calculate_current_priority();
-			break;
-		}
-	}
-	ft_mutex_unlock(asset_thread_task_mtx);
+// Puts a task that's partway through its actions back at the front of the
+// queue of the last thread that worked on it.
+void assets_resume_task(asset_task_t *task) {
+	asset_queue_t *queue = &asset_queues[task->worker];
+	ft_mutex_lock(queue->mtx);
+	queue->resume.add(task);
+	queue->cost += task->complexity;
+	ft_mutex_unlock(queue->mtx);
+
+	assets_wake_thread();
+}
 
+///////////////////////////////////////////
+
+asset_task_t *assets_queue_pop(int32_t queue_idx) {
+	asset_queue_t *queue  = &asset_queues[queue_idx];
+	asset_task_t  *result = nullptr;
+	ft_mutex_lock(queue->mtx);
+	if      (queue->resume.count > 0) { result = queue->resume.last(); queue->resume.pop(); }
+	else if (queue->heap  .count > 0) { result = assets_heap_pop(&queue->heap); }
+	if (result != nullptr) queue->cost -= result->complexity;
+	ft_mutex_unlock(queue->mtx);
 	return result;
 }
 
 ///////////////////////////////////////////
 
-void assets_return_task(asset_task_t *task) {
-	ft_mutex_lock(asset_thread_task_mtx);
-	asset_active_tasks.remove(asset_active_tasks.index_of(task));
-	asset_thread_tasks.insert(0, task);
-	ft_mutex_unlock(asset_thread_task_mtx);
+asset_task_t *assets_acquire_task(int32_t queue_idx) {
+	// Our own queue first, then steal from whoever has the most work
+	// waiting. Tasks with no estimate don't show up in the costs, so if
+	// that finds nothing, check everyone.
+	asset_task_t *result = assets_queue_pop(queue_idx);
+	if (result == nullptr) {
+		int32_t busiest = -1;
+		int64_t most    = 0;
+		for (int32_t i = 0; i < asset_queues.count; i++) {
+			if (i != queue_idx && asset_queues[i].cost > most) {
+				busiest = i;
+				most    = asset_queues[i].cost;
+			}
+		}
+		if (busiest != -1) result = assets_queue_pop(busiest);
+	}
+	for (int32_t i = 1; i < asset_queues.count && result == nullptr; i++) {
+		result = assets_queue_pop((queue_idx + i) % asset_queues.count);
+	}
 
-	if (asset_thread_tasks.count > 1) ft_condition_broadcast(asset_tasks_available);
-	else                              ft_condition_signal   (asset_tasks_available);
+	if (result != nullptr) {
+		atomic_decrement(&asset_tasks_queued);
+		result->worker = queue_idx;
+	}
+	return result;
 }
 
 ///////////////////////////////////////////
 
 void assets_complete_task(asset_task_t* task) {
-	// Skip putting it back if it's complete :)
+	asset_task_timing_t timing = {};
+	timing.type       = task->asset->type;
+	timing.priority   = task->priority;
+	timing.complexity = task->complexity;
+	timing.wait_ms    = (float)stm_ms(stm_diff(task->time_started, task->time_added));
+	timing.thread_ms  = (float)stm_ms(task->time_thread);
+	timing.gpu_ms     = (float)stm_ms(task->time_gpu);
+	timing.total_ms   = (float)stm_ms(stm_since(task->time_added));
 
 	ft_mutex_lock(asset_thread_task_mtx);
-	asset_active_tasks.remove(asset_active_tasks.index_of(task));
 	asset_tasks_finished   += 1;
 	asset_tasks_processing -= 1;
-	asset_tasks_priority    = assets_calculate_current_priority();
+	assets_priority_change(task->priority, -1);
+	asset_task_timings[asset_task_timing_total % _countof(asset_task_timings)] = timing;
+	asset_task_timing_total += 1;
 	ft_mutex_unlock(asset_thread_task_mtx);
 
 	// If it was successfully loaded, we'll want to notify on_load, but we do
@@ -659,19 +1001,51 @@ void assets_complete_task(asset_task_t* task) {
 
 ///////////////////////////////////////////
 
+// Actions call this once they know more about how much work is left, like
+// after reading an image's header. The task is out of the queues while its
+// action runs, so this only needs to note that it should be sorted again.
 void assets_task_set_complexity(asset_task_t *task, int32_t complexity) {
+	if (complexity < 0) complexity = 0;
+	if (task->complexity == complexity) return;
+	task->complexity = complexity;
+	task->sort       = asset_sort(task->priority, complexity, true);
+	task->resort     = true;
+}
+
+///////////////////////////////////////////
+
+int32_t assets_task_timing_count() {
+	int32_t max = _countof(asset_task_timings);
+	return asset_task_timing_total < max ? asset_task_timing_total : max;
 }
 
 ///////////////////////////////////////////
 
-void asset_step_task() {
-	asset_task_t* task = assets_acquire_task();
-	if (task == nullptr) return;
+// Index 0 is the oldest timing still kept.
+asset_task_timing_t assets_task_timing_get(int32_t index) {
+	asset_task_timing_t result = {};
+	int32_t             count  = assets_task_timing_count();
+	if (index < 0 || index >= count) return result;
+
+	ft_mutex_lock(asset_thread_task_mtx);
+	result = asset_task_timings[(asset_task_timing_total - count + index) % _countof(asset_task_timings)];
+	ft_mutex_unlock(asset_thread_task_mtx);
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool asset_step_task(int32_t queue_idx) {
+	asset_task_t* task = assets_acquire_task(queue_idx);
+	if (task == nullptr) return false;
+	if (task->time_started == 0) task->time_started = stm_now();
 
 	asset_load_action_t* action = &task->actions[task->action_curr];
 	if (action->thread_affinity == asset_thread_asset) {
 		// Execute the asset loading action!
-		bool result = action->action(task, task->asset, task->load_data);
+		uint64_t start  = stm_now();
+		bool     result = action->action(task, task->asset, task->load_data);
+		task->time_thread += stm_since(start);
 
 		if (result == false) {
 			// On failure, send an error message, and move to the end
@@ -689,6 +1063,7 @@ void asset_step_task() {
 
 			// Set up a job for the GPU thread
 			task->gpu_job.data = task;
+			task->gpu_job.task = task;
 			task->gpu_job.asset_job = [](void* data) {
 				asset_task_t* task = (asset_task_t*)data;
 				asset_load_action_t* action = &task->actions[task->action_curr];
@@ -697,10 +1072,12 @@ void asset_step_task() {
 				return (bool32_t)result;
 			};
 
-			// Add the job to the list
+			// Add the job to the list, assets_step will put the task back
+			// in the queue once it's done.
 			ft_mutex_lock(assets_job_lock);
 			assets_gpu_jobs.add(&task->gpu_job);
 			ft_mutex_unlock(assets_job_lock);
+			return true;
 		} else if (task->gpu_job.finished) {
 			if (task->gpu_job.success == false) {
 				// On failure, send an error message, and move to
@@ -718,12 +1095,19 @@ void asset_step_task() {
 		}
 	}
 
-	// Put it back in when we're done!
+	// Put it back in when we're done! If its cost estimate changed, it
+	// goes back through the heap so it waits behind cheaper work.
 	if (task->action_curr < task->action_count) {
-		assets_return_task(task);
+		if (task->resort) {
+			task->resort = false;
+			assets_queue_task(task);
+		} else {
+			assets_resume_task(task);
+		}
 	} else {
 		assets_complete_task(task);
 	}
+	return true;
 }
 
 ///////////////////////////////////////////
@@ -732,17 +1116,23 @@ int32_t asset_thread(void *thread_inst_obj) {
 	asset_thread_t* thread = (asset_thread_t*)thread_inst_obj;
 	thread->id      = ft_id_current();
 	thread->running = true;
-	 
-	ft_mutex_t wait_mtx = ft_mutex_create();
 
-	while (asset_thread_enabled || asset_thread_tasks.count>0) {
-		asset_step_task();
+	while (asset_thread_enabled || asset_tasks_processing > 0) {
+		if (asset_step_task(thread->queue))
+			continue;
 
-		if (asset_thread_enabled && asset_thread_tasks.count == 0)
-			ft_condition_wait(asset_tasks_available, wait_mtx);
+		// Nothing to do right now. Tasks may still be waiting on the GPU
+		// during shutdown, but otherwise sleep until something shows up.
+		if (!asset_thread_enabled) {
+			ft_yield();
+			continue;
+		}
+		ft_mutex_lock(asset_tasks_sleep_mtx);
+		if (asset_thread_enabled && asset_tasks_queued <= 0)
+			ft_condition_wait(asset_tasks_available, asset_tasks_sleep_mtx);
+		ft_mutex_unlock(asset_tasks_sleep_mtx);
 	}
 
-	ft_mutex_destroy(&wait_mtx);
 	thread->running = false;
 	return 0;
 }
@@ -6,19 +6,24 @@
 namespace sk {
 
 struct asset_header_t {
-	asset_type_  type;
-	asset_state_ state;
-	uint64_t     id;
-	uint64_t     index;
-	int32_t      refs;
-	char        *id_text;
+	asset_type_     type;
+	asset_state_    state;
+	uint64_t        id;
+	uint64_t        index;
+	int32_t         refs;
+	char           *id_text;
+	uint64_t        destroy_frame; // Non-zero while waiting on assets_frame_end to destroy it
+	asset_header_t *id_next;       // Next asset with the same id and type, see assets_index.h
 };
 
+struct asset_task_t;
+
 struct asset_job_t {
-	bool32_t  finished;
-	bool32_t  success;
-	void     *data;
-	bool32_t(*asset_job)(void *data);
+	bool32_t      finished;
+	bool32_t      success;
+	void         *data;
+	bool32_t    (*asset_job)(void *data);
+	asset_task_t *task; // If set, this task gets queued again once the job is done
 };
 
 typedef enum asset_thread_ {
@@ -26,8 +31,6 @@ typedef enum asset_thread_ {
 	asset_thread_gpu,
 } asset_thread_;
 
-struct asset_task_t;
-
 struct asset_load_action_t {
 	bool32_t    (*action)(asset_task_t *task, asset_header_t *asset, void *data);
 	asset_thread_ thread_affinity;
@@ -42,13 +45,22 @@ struct asset_task_t {
 	int32_t              action_count;
 	int32_t              action_curr;
 	int32_t              priority;
+	int32_t              complexity; // Estimated cost, roughly in pixels or bytes to decode
 	int64_t              sort;
 	asset_job_t          gpu_job;
 	bool32_t             gpu_started;
+	bool32_t             resort;     // Complexity changed while running, re-queue by sort
+	uint64_t             order;      // Breaks ties in sort, first come first served
+	int32_t              worker;     // Queue of the last worker to run this task
+	uint64_t             time_added;
+	uint64_t             time_started;
+	uint64_t             time_thread;
+	uint64_t             time_gpu;
 };
 
 void *assets_find          (const char *id, asset_type_ type);
 void *assets_find          (uint64_t    id, asset_type_ type);
+void *assets_find_ref      (const char *id, asset_type_ type);
 void *assets_allocate      (asset_type_ type);
 void  assets_destroy       (asset_header_t *asset);
 void  assets_set_id        (asset_header_t *header, const char *id);
@@ -57,6 +69,7 @@ void  assets_unique_name   (asset_type_ type, const char *root_name, char *dest,
 void  assets_addref        (asset_header_t *asset);
 void  assets_releaseref    (asset_header_t *asset);
 void  assets_safeswap_ref  (asset_header_t **asset_link, asset_header_t *asset);
+void  assets_frame_end     (bool32_t destroy_all);
 void  assets_shutdown_check();
 char *assets_file          (const char *file_name);
 bool  assets_init          ();
@@ -69,9 +82,12 @@ void  assets_on_load_remove(asset_header_t *asset, void (*on_load)(asset_header_
 // ensure it is run on the GPU thread.
 bool32_t assets_execute_gpu        (bool32_t (*asset_job)(void *data), void *data);
 void     assets_add_task           (asset_task_t task);
-void     assets_task_set_complexity(asset_task_t *task, int32_t priority);
+void     assets_task_set_complexity(asset_task_t *task, int32_t complexity);
 void     assets_block_until        (asset_header_t *asset, asset_state_ state);
 
-inline int64_t asset_sort(int32_t priority, int32_t complexity) { return ((int64_t)priority << 32) | ((int64_t)complexity); }
+// Within a priority, tasks that have already started sort ahead of ones
+// that haven't, so a task that has read its file in finishes before more
+// files get read in. Then it's cheapest first.
+inline int64_t asset_sort(int32_t priority, int32_t complexity, bool started) { return ((int64_t)priority << 32) | (started ? 0 : 0x80000000LL) | ((int64_t)complexity & 0x7FFFFFFF); }
 
 } // namespace sk
\ No newline at end of file
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "assets.h"
+#include "../libraries/array.h"
+
+namespace sk {
+
+///////////////////////////////////////////
+// Asset id index                        //
+///////////////////////////////////////////
+
+// Maps an (id, type) pair to the assets that have it, so finding an asset
+// by id doesn't need to look at every asset. Ids aren't always unique: an
+// asset waiting to be destroyed can share its id with a new one, so each
+// entry is the head of a list linked through asset_header_t::id_next,
+// oldest first.
+
+struct asset_index_key_t {
+	uint64_t id;
+	uint64_t type;
+};
+
+typedef hashmap_t<asset_index_key_t, asset_header_t *> asset_index_t;
+
+///////////////////////////////////////////
+
+inline void asset_index_add(asset_index_t *index, asset_header_t *asset) {
+	asset_index_key_t key  = { asset->id, (uint64_t)asset->type };
+	asset_header_t  **head = index->get(key);
+	asset->id_next = nullptr;
+	if (head == nullptr) {
+		index->set(key, asset);
+		return;
+	}
+	asset_header_t *curr = *head;
+	while (curr->id_next != nullptr) curr = curr->id_next;
+	curr->id_next = asset;
+}
+
+///////////////////////////////////////////
+
+inline void asset_index_remove(asset_index_t *index, asset_header_t *asset) {
+	asset_index_key_t key  = { asset->id, (uint64_t)asset->type };
+	int32_t           slot = index->contains(key);
+	if (slot == -1) return;
+
+	asset_header_t **link = &index->items[slot].value;
+	while (*link != nullptr && *link != asset) link = &(*link)->id_next;
+	if (*link == nullptr) return;
+
+	*link = asset->id_next;
+	asset->id_next = nullptr;
+	if (index->items[slot].value == nullptr)
+		index->remove_at(slot);
+}
+
+///////////////////////////////////////////
+
+// The first asset with this id and type that's still referenced.
+inline asset_header_t *asset_index_find(asset_index_t *index, uint64_t id, asset_type_ type) {
+	asset_index_key_t key  = { id, (uint64_t)type };
+	asset_header_t  **head = index->get(key);
+	if (head == nullptr) return nullptr;
+
+	for (asset_header_t *curr = *head; curr != nullptr; curr = curr->id_next) {
+		if (curr->refs > 0) return curr;
+	}
+	return nullptr;
+}
+
+} // namespace sk
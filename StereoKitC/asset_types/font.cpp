@@ -128,12 +128,7 @@ void font_source_release(int32_t id) {
 ///////////////////////////////////////////
 
 font_t font_find(const char *id) {
-	font_t result = (font_t)assets_find(id, asset_type_font);
-	if (result != nullptr) {
-		font_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (font_t)assets_find_ref(id, asset_type_font);
 }
 
 ///////////////////////////////////////////
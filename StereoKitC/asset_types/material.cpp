@@ -22,12 +22,7 @@ void material_update_label (material_t material);
 ///////////////////////////////////////////
 
 material_t material_find(const char *id) {
-	material_t result = (material_t)assets_find(id, asset_type_material);
-	if (result != nullptr) {
-		material_addref(result);
-		return result;
-	}
-	return result;
+	return (material_t)assets_find_ref(id, asset_type_material);
 }
 
 ///////////////////////////////////////////
@@ -422,12 +422,7 @@ void mesh_update_skin(mesh_t mesh, const matrix *bone_transforms, int32_t bone_c
 ///////////////////////////////////////////
 
 mesh_t mesh_find(const char *id) {
-	mesh_t result = (mesh_t)assets_find(id, asset_type_mesh);
-	if (result != nullptr) {
-		mesh_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (mesh_t)assets_find_ref(id, asset_type_mesh);
 }
 
 ///////////////////////////////////////////
@@ -526,7 +521,7 @@ const mesh_bvh_t *mesh_get_bvh_data(mesh_t mesh) {
 	if (mesh->discard_data)
 		return nullptr;
 
-	mesh->bvh_data = mesh_bvh_create(mesh, 16);
+	mesh->bvh_data = mesh_bvh_create_cached(mesh, 16);
 
 	return mesh->bvh_data;
 }
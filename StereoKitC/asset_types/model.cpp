@@ -5,7 +5,9 @@
 #include "../sk_memory.h"
 #include "model.h"
 #include "mesh.h"
+#include "asset_cache.h"
 #include "../libraries/stref.h"
+#include "../libraries/ferr_hash.h"
 #include "../platforms/platform_utils.h"
 
 using namespace DirectX;
@@ -39,12 +41,7 @@ const char* model_get_id(const model_t model) {
 ///////////////////////////////////////////
 
 model_t model_find(const char *id) {
-	model_t result = (model_t)assets_find(id, asset_type_model);
-	if (result != nullptr) {
-		model_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (model_t)assets_find_ref(id, asset_type_model);
 }
 
 ///////////////////////////////////////////
@@ -64,6 +61,11 @@ model_t model_copy(model_t model) {
 	for (int32_t i = 0; i < result->visuals.count; i++) {
 		material_addref(result->visuals[i].material);
 		mesh_addref    (result->visuals[i].mesh);
+		result->visuals[i].lods = result->visuals[i].lods.copy();
+		for (int32_t l = 0; l < result->visuals[i].lods.count; l++) {
+			if (result->visuals[i].lods[l].mesh    ) mesh_addref    (result->visuals[i].lods[l].mesh);
+			if (result->visuals[i].lods[l].material) material_addref(result->visuals[i].lods[l].material);
+		}
 	}
 	for (int32_t i = 0; i < result->nodes.count; i++) {
 		result->nodes[i].name = string_copy(result->nodes[i].name);
@@ -99,10 +101,18 @@ model_t model_create_mesh(mesh_t mesh, material_t material) {
 
 model_t model_create_mem(const char *filename, void *data, size_t data_size, shader_t shader) {
 	model_t result = model_create();
-	
-	if (string_endswith(filename, ".glb",  false) || 
+
+	// glTF can keep its vertex data in other files, so it checks the cache
+	// itself once those are loaded.
+	bool          is_gltf = 
+		string_endswith(filename, ".glb",  false) || 
 		string_endswith(filename, ".gltf", false) ||
-		string_endswith(filename, ".vrm",  false)) {
+		string_endswith(filename, ".vrm",  false);
+	model_cache_t cache   = {};
+	if (!is_gltf && asset_cache_enabled())
+		model_cache_begin(&cache, filename, asset_cache_hash(data, data_size, HASH_FNV64_START));
+	
+	if (is_gltf) {
 		if (!modelfmt_gltf(result, filename, data, data_size, shader))
 			log_errf("Issue loading GLTF file: %s!", filename);
 	} else if (string_endswith(filename, ".obj", false)) {
@@ -117,12 +127,83 @@ model_t model_create_mem(const char *filename, void *data, size_t data_size, sha
 	} else {
 		log_errf("Issue loading %s! Unrecognized file extension.", filename);
 	}
+	model_cache_end(&cache, result);
 
 	return result;
 }
 
 ///////////////////////////////////////////
 
+const uint32_t model_cache_tag_id    = asset_cache_tag('m','i','d',' ');
+const uint32_t model_cache_tag_verts = asset_cache_tag('v','e','r','t');
+const uint32_t model_cache_tag_inds  = asset_cache_tag('i','n','d','s');
+
+void model_cache_begin(model_cache_t *cache, const char *filename, uint64_t content_hash) {
+	if (!asset_cache_enabled()) return;
+
+	cache->key  = hash_fnv64_string(filename, hash_fnv64_string("sk_model"));
+	cache->hash = content_hash;
+	asset_cache_t *entry = asset_cache_open(cache->key, cache->hash);
+	if (entry == nullptr) return;
+
+	int32_t count = asset_cache_count(entry, model_cache_tag_id);
+	for (int32_t i = 0; i < count; i++) {
+		uint64_t      id_size   = 0;
+		uint64_t      vert_size = 0;
+		uint64_t      ind_size  = 0;
+		const char   *id        = (const char   *)asset_cache_get(entry, model_cache_tag_id,    i, &id_size);
+		const vert_t *verts     = (const vert_t *)asset_cache_get(entry, model_cache_tag_verts, i, &vert_size);
+		const vind_t *inds      = (const vind_t *)asset_cache_get(entry, model_cache_tag_inds,  i, &ind_size);
+		if (id == nullptr || id_size == 0 || id[id_size - 1] != '\0' || verts == nullptr || inds == nullptr) break;
+
+		mesh_t mesh = mesh_find(id);
+		if (mesh == nullptr) {
+			mesh = mesh_create();
+			mesh_set_id  (mesh, id);
+			mesh_set_data(mesh, verts, (int32_t)(vert_size / sizeof(vert_t)), inds, (int32_t)(ind_size / sizeof(vind_t)));
+		}
+		cache->meshes.add(mesh);
+	}
+	cache->hit = true;
+	asset_cache_close(entry);
+}
+
+///////////////////////////////////////////
+
+void model_cache_end(model_cache_t *cache, model_t model) {
+	if (cache->key != 0 && !cache->hit) {
+		array_t<mesh_t>                meshes   = {};
+		array_t<asset_cache_section_t> sections = {};
+		for (int32_t v = 0; v < model->visuals.count; v++) {
+			model_visual_t *visual = &model->visuals[v];
+			for (int32_t l = -1; l < visual->lods.count; l++) {
+				mesh_t mesh = l == -1 ? visual->mesh : visual->lods[l].mesh;
+
+				// Only meshes the loaders named can be found again, and they
+				// need their data around to be written.
+				if (mesh == nullptr || mesh->discard_data || mesh->verts == nullptr || mesh->inds == nullptr ||
+					mesh->header.id_text == nullptr || string_startswith(mesh->header.id_text, "auto/") ||
+					meshes.index_of(mesh) != -1)
+					continue;
+				meshes  .add(mesh);
+				sections.add({ model_cache_tag_id,    mesh->header.id_text, strlen(mesh->header.id_text) + 1 });
+				sections.add({ model_cache_tag_verts, mesh->verts,          sizeof(vert_t) * mesh->vert_count });
+				sections.add({ model_cache_tag_inds,  mesh->inds,           sizeof(vind_t) * mesh->ind_count  });
+			}
+		}
+		if (sections.count > 0)
+			asset_cache_write(cache->key, cache->hash, sections.data, sections.count);
+		meshes  .free();
+		sections.free();
+	}
+
+	for (int32_t i = 0; i < cache->meshes.count; i++)
+		mesh_release(cache->meshes[i]);
+	cache->meshes.free();
+}
+
+///////////////////////////////////////////
+
 model_t model_create_file(const char *filename, shader_t shader) {
 	model_t result = model_find(filename);
 	if (result != nullptr)
@@ -312,6 +393,7 @@ void model_remove_subset(model_t model, int32_t subset) {
 	model->nodes[model->visuals[subset].node].visual = -1;
 	mesh_release    (model->visuals[subset].mesh);
 	material_release(model->visuals[subset].material);
+	model_visual_clear_lods(&model->visuals[subset]);
 	model->visuals.remove(subset);
 
 	for (int32_t i = 0; i < model->nodes.count; i++) {
@@ -465,6 +547,7 @@ void model_destroy(model_t model) {
 	for (int32_t i = 0; i < model->visuals.count; i++) {
 		mesh_release    (model->visuals[i].mesh);
 		material_release(model->visuals[i].material);
+		model_visual_clear_lods(&model->visuals[i]);
 	}
 	model->nodes  .free();
 	model->visuals.free();
@@ -739,6 +822,52 @@ void model_node_set_mesh(model_t model, model_node_id node, mesh_t mesh) {
 
 ///////////////////////////////////////////
 
+void model_node_add_lod(model_t model, model_node_id node, mesh_t mesh, material_t material, float screen_coverage) {
+	int32_t vis = model->nodes[node].visual;
+	if (vis < 0 || model->visuals[vis].mesh == nullptr) {
+		log_err("model_node_add_lod needs a node that already has a mesh!");
+		return;
+	}
+
+	// Keep the chain sorted from most to least detailed, so the renderer
+	// can stop at the first level that's small enough.
+	array_t<model_lod_t> *lods = &model->visuals[vis].lods;
+	int32_t at = lods->count;
+	while (at > 0 && lods->get(at - 1).screen_coverage < screen_coverage)
+		at--;
+
+	if (mesh    ) mesh_addref    (mesh);
+	if (material) material_addref(material);
+	lods->insert(at, { mesh, material, screen_coverage });
+}
+
+///////////////////////////////////////////
+
+int32_t model_node_lod_count(model_t model, model_node_id node) {
+	int32_t vis = model->nodes[node].visual;
+	return vis < 0 ? 0 : model->visuals[vis].lods.count;
+}
+
+///////////////////////////////////////////
+
+void model_node_clear_lods(model_t model, model_node_id node) {
+	int32_t vis = model->nodes[node].visual;
+	if (vis >= 0)
+		model_visual_clear_lods(&model->visuals[vis]);
+}
+
+///////////////////////////////////////////
+
+void model_visual_clear_lods(model_visual_t *visual) {
+	for (int32_t i = 0; i < visual->lods.count; i++) {
+		mesh_release    (visual->lods[i].mesh);
+		material_release(visual->lods[i].material);
+	}
+	visual->lods.free();
+}
+
+///////////////////////////////////////////
+
 void _model_node_update_transforms(model_t model, model_node_id node) {
 	if (model->nodes[node].parent >= 0)
 		model->nodes[node].transform_model = model->nodes[node].transform_local * model->nodes[model->nodes[node].parent].transform_model;
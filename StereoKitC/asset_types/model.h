@@ -7,12 +7,23 @@
 
 namespace sk {
 
+// A lower detail stand-in for a visual's mesh. It's drawn once the visual
+// covers less than screen_coverage of the screen's height. A null mesh means
+// the visual isn't drawn at all at that size, and a null material means the
+// visual's own material is used.
+struct model_lod_t {
+	mesh_t        mesh;
+	material_t    material;
+	float         screen_coverage;
+};
+
 struct model_visual_t {
 	model_node_id node;
 	mesh_t        mesh;
 	material_t    material;
 	matrix        transform_model;
 	bool32_t      visible;
+	array_t<model_lod_t> lods; // Sorted from most to least detailed
 };
 
 struct model_node_t {
@@ -39,10 +50,25 @@ struct _model_t {
 	bool32_t                bounds_dirty;
 };
 
+// Meshes a model loaded from a file last time, from the asset cache. On a
+// hit, the meshes are created with the ids the loaders look up with
+// mesh_find, so the loaders just pick them up instead of building them. On
+// a miss, model_cache_end writes the model's meshes to the cache.
+struct model_cache_t {
+	uint64_t        key;
+	uint64_t        hash;
+	bool32_t        hit;
+	array_t<mesh_t> meshes;
+};
+
+void model_cache_begin(model_cache_t *cache, const char *filename, uint64_t content_hash);
+void model_cache_end  (model_cache_t *cache, model_t model);
+
 bool modelfmt_obj (model_t model, const char *filename, void *file_data, size_t file_size, shader_t shader);
 bool modelfmt_gltf(model_t model, const char *filename, void *file_data, size_t file_size, shader_t shader);
 bool modelfmt_stl (model_t model, const char *filename, void *file_data, size_t file_size, shader_t shader);
 bool modelfmt_ply (model_t model, const char *filename, void *file_data, size_t file_size, shader_t shader);
 void model_destroy(model_t model);
+void model_visual_clear_lods(model_visual_t *visual);
 
 } // namespace sk
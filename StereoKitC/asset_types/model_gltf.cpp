@@ -3,6 +3,7 @@
 #include "model.h"
 #include "mesh_.h"
 #include "texture_.h"
+#include "asset_cache.h"
 #include "../sk_math.h"
 #include "../sk_memory.h"
 #include "../systems/defaults.h"
@@ -28,8 +29,12 @@ matrix gltf_build_node_matrix (cgltf_node *curr);
 matrix gltf_build_world_matrix(cgltf_node *curr, cgltf_node *root);
 void   gltf_add_warning       (array_t<const char *> *warnings, const char *text);
 
-// This needs to be in cgltf.cpp due to the location of the json parser
-void gltf_parse_extras(model_t model, model_node_id node, const char* extras_json, size_t extras_size);
+// These need to be in cgltf.cpp due to the location of the json parser
+void    gltf_parse_extras      (model_t model, model_node_id node, const char* extras_json, size_t extras_size);
+int32_t gltf_parse_number_array(const char *json, const char *key, float *out_values, int32_t max_values);
+
+// MSFT_lod chains longer than this are cut short
+const int32_t gltf_lod_max = 8;
 
 ///////////////////////////////////////////
 
@@ -691,8 +696,12 @@ anim_t gltf_parseanim(const cgltf_animation *anim, hashmap_t<cgltf_node*, model_
 	for (size_t c = 0; c < anim->channels_count; c++) {
 		cgltf_animation_channel *ch = &anim->channels[c];
 
+		// Nodes that are only MSFT_lod levels aren't in the model.
+		model_node_id *target = node_map->get(ch->target_node);
+		if (target == nullptr) continue;
+
 		anim_curve_t curve = {};
-		curve.node_id = *node_map->get(ch->target_node);
+		curve.node_id = *target;
 
 		switch (ch->sampler->interpolation) {
 		case cgltf_interpolation_type_linear:       curve.interpolation = anim_interpolation_linear; break;
@@ -784,6 +793,69 @@ int32_t gltf_node_index(cgltf_data *data, cgltf_node *node) {
 
 ///////////////////////////////////////////
 
+// MSFT_lod lists lower detail nodes for a node, and MSFT_screencoverage in
+// the node's extras has the minimum screen coverage for each level, starting
+// with the node itself. An extra coverage value past the last level is the
+// point where the node isn't drawn at all.
+// https://github.com/KhronosGroup/glTF/tree/main/extensions/2.0/Vendor/MSFT_lod
+int32_t gltf_lod_ids(cgltf_node *node, int32_t *out_ids) {
+	for (cgltf_size e = 0; e < node->extensions_count; e++) {
+		if (!string_eq(node->extensions[e].name, "MSFT_lod") || node->extensions[e].data == nullptr) continue;
+
+		float   ids[gltf_lod_max];
+		int32_t count = gltf_parse_number_array(node->extensions[e].data, "ids", ids, gltf_lod_max);
+		for (int32_t i = 0; i < count; i++) out_ids[i] = (int32_t)ids[i];
+		return count;
+	}
+	return 0;
+}
+
+///////////////////////////////////////////
+
+void gltf_add_lods(model_t model, shader_t shader, model_node_id sk_node, const char *filename, cgltf_data *data, cgltf_node *node, int primitive_id, array_t<const char *> *warnings) {
+	int32_t ids[gltf_lod_max];
+	int32_t id_count = gltf_lod_ids(node, ids);
+	if (id_count == 0) return;
+
+	float   coverage[gltf_lod_max + 1];
+	int32_t coverage_count = node->extras.data
+		? gltf_parse_number_array(node->extras.data, "MSFT_screencoverage", coverage, gltf_lod_max + 1)
+		: 0;
+
+	const cgltf_primitive *base = &node->mesh->primitives[primitive_id];
+	for (int32_t l = 0; l < id_count; l++) {
+		// Without a coverage value, each level gets half the coverage of
+		// the one before it.
+		float level_coverage = l < coverage_count ? coverage[l] : powf(0.5f, (float)(l + 1));
+
+		if (ids[l] < 0 || ids[l] >= (int32_t)data->nodes_count) {
+			gltf_add_warning(warnings, "MSFT_lod references a node that doesn't exist");
+			continue;
+		}
+
+		// Each of our visuals is a single primitive, so the LOD's mesh is
+		// the primitive at the same index in the LOD node's mesh. If the
+		// LOD has fewer primitives, this one just isn't drawn at that level.
+		cgltf_node *lod_node = &data->nodes[ids[l]];
+		mesh_t      mesh     = nullptr;
+		material_t  material = nullptr;
+		if (lod_node->mesh && (cgltf_size)primitive_id < lod_node->mesh->primitives_count) {
+			mesh = gltf_parsemesh(lod_node->mesh, ids[l], primitive_id, filename, warnings);
+			const cgltf_primitive *prim = &lod_node->mesh->primitives[primitive_id];
+			if (prim->material != base->material)
+				material = gltf_parsematerial(data, prim->material, filename, shader, warnings);
+		}
+		model_node_add_lod(model, sk_node, mesh, material, level_coverage);
+		mesh_release    (mesh);
+		material_release(material);
+	}
+
+	if (coverage_count > id_count)
+		model_node_add_lod(model, sk_node, nullptr, nullptr, coverage[id_count]);
+}
+
+///////////////////////////////////////////
+
 void gltf_add_node(model_t model, shader_t shader, model_node_id parent, const char *filename, cgltf_data *data, cgltf_node *node, hashmap_t<cgltf_node*, model_node_id> *node_map, array_t<const char *> *warnings) {
 	int32_t       index   = (int32_t)(node - data->nodes);
 	model_node_id node_id = -1;
@@ -810,6 +882,7 @@ void gltf_add_node(model_t model, shader_t shader, model_node_id parent, const c
 		model_node_id new_node = model_node_add_child(model, primitive_parent, node->name, node_transform, mesh, material);
 		if (node->skin) 
 			gltf_parseskin(model_node_get_mesh(model, new_node), node, (int)p, filename);
+		gltf_add_lods(model, shader, new_node, filename, data, node, (int)p, warnings);
 		if (node_id == -1)
 			node_id = new_node;
 
@@ -864,15 +937,41 @@ bool modelfmt_gltf(model_t model, const char *filename, void *file_data, size_t
 		return false;
 	}
 
+	// The meshes may be in the asset cache. The vertex data can live in
+	// other files, so the match is against those buffers as well.
+	model_cache_t cache = {};
+	if (asset_cache_enabled()) {
+		uint64_t hash = asset_cache_hash(file_data, file_size, HASH_FNV64_START);
+		for (cgltf_size i = 0; i < data->buffers_count; i++) {
+			if (data->buffers[i].data != nullptr)
+				hash = asset_cache_hash(data->buffers[i].data, data->buffers[i].size, hash);
+		}
+		model_cache_begin(&cache, filename, hash);
+	}
+
 	array_t<const char *> warnings = {};
 
+	// Nodes that are only here as another node's MSFT_lod level are
+	// loaded as part of that node, and aren't part of the hierarchy.
+	bool *lod_only = sk_malloc_t(bool, data->nodes_count);
+	memset(lod_only, 0, sizeof(bool) * data->nodes_count);
+	for (cgltf_size i = 0; i < data->nodes_count; i++) {
+		int32_t ids[gltf_lod_max];
+		int32_t id_count = gltf_lod_ids(&data->nodes[i], ids);
+		for (int32_t l = 0; l < id_count; l++) {
+			if (ids[l] >= 0 && ids[l] < (int32_t)data->nodes_count)
+				lod_only[ids[l]] = true;
+		}
+	}
+
 	// Load each root node
 	hashmap_t<cgltf_node*, model_node_id> node_map = {};
 	for (cgltf_size i = 0; i < data->nodes_count; i++) {
 		cgltf_node *n = &data->nodes[i];
-		if (n->parent == nullptr)
+		if (n->parent == nullptr && !lod_only[i])
 			gltf_add_node(model, shader, -1, filename, data, n, &node_map, &warnings);
 	}
+	sk_free(lod_only);
 
 	// Load each animation
 	for (cgltf_size i = 0; i < data->animations_count; i++) {
@@ -884,6 +983,7 @@ bool modelfmt_gltf(model_t model, const char *filename, void *file_data, size_t
 		if (data->nodes[i].skin == nullptr) continue;
 		cgltf_skin *skin = data->nodes[i].skin;
 		cgltf_node *node = &data->nodes[i];
+		if (node_map.get(node) == nullptr) continue;
 
 		// Each GLTF skin node has an sk_mesh node for each of its primitives.
 		for (cgltf_size p = 0; node->mesh && p < node->mesh->primitives_count; p++) {
@@ -902,6 +1002,7 @@ bool modelfmt_gltf(model_t model, const char *filename, void *file_data, size_t
 		log_warnf("[%s] %s", filename, warnings[i]);
 	}
 
+	model_cache_end(&cache, model);
 	warnings.free();
 	node_map.free();
 	cgltf_free(data);
@@ -14,12 +14,7 @@ void shader_update_label(shader_t shader);
 ///////////////////////////////////////////
 
 shader_t shader_find(const char *id) {
-	shader_t result = (shader_t)assets_find(id, asset_type_shader);
-	if (result != nullptr) {
-		shader_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (shader_t)assets_find_ref(id, asset_type_shader);
 }
 
 ///////////////////////////////////////////
@@ -14,12 +14,7 @@ namespace sk {
 ///////////////////////////////////////////
 
 sound_t sound_find(const char *id) {
-	sound_t result = (sound_t)assets_find(id, asset_type_sound);
-	if (result != nullptr) {
-		sound_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (sound_t)assets_find_ref(id, asset_type_sound);
 }
 
 ///////////////////////////////////////////
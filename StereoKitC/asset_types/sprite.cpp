@@ -31,12 +31,7 @@ int32_t      sprite_map_count = 0;
 ///////////////////////////////////////////
 
 sprite_t sprite_find(const char* id) {
-	sprite_t result = (sprite_t)assets_find(id, asset_type_sprite);
-	if (result != nullptr) {
-		sprite_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (sprite_t)assets_find_ref(id, asset_type_sprite);
 }
 
 ///////////////////////////////////////////
@@ -8,6 +8,7 @@
 #include "../spherical_harmonics.h"
 #include "texture.h"
 #include "texture_.h"
+#include "asset_cache.h"
 
 #pragma warning(push)
 #pragma warning(disable : 26451 6011 6262 6308 6387 28182 26819 )
@@ -36,6 +37,7 @@ namespace sk {
 void *tex_load_image_data(void *data, size_t data_size, bool32_t srgb_data, tex_format_ *out_format, int32_t *out_width, int32_t *out_height);
 bool  tex_load_image_info(void *data, size_t data_size, bool32_t srgb_data, int32_t *out_width, int32_t *out_height, tex_format_ *out_format);
 void  tex_update_label   (tex_t texture);
+spherical_harmonics_t tex_faces_lighting(void **faces, int32_t size, tex_format_ format);
 void _tex_set_options    (skg_tex_t* texture, tex_sample_ sample, tex_address_ address_mode, int32_t anisotropy_level);
 
 const char *tex_msg_load_failed           = "Texture file failed to load: %s";
@@ -62,8 +64,19 @@ struct tex_load_t {
 	void    **color_data;
 	int32_t   color_width;
 	int32_t   color_height;
+
+	// With an asset cache, the key and source hash for this texture's entry.
+	// If the entry was found, color_data points into it rather than owning
+	// its memory.
+	uint64_t       cache_key;
+	uint64_t       cache_hash;
+	asset_cache_t *cache;
+	void          *cache_faces[6];
 };
 
+const uint32_t tex_cache_tag_color = asset_cache_tag('c','o','l','r');
+const uint32_t tex_cache_tag_sh    = asset_cache_tag('s','h','9',' ');
+
 ///////////////////////////////////////////
 
 void tex_load_free(asset_header_t *, void *job_data) {
@@ -72,8 +85,12 @@ void tex_load_free(asset_header_t *, void *job_data) {
 	for (int32_t i = 0; i < data->file_count; i++) {
 		if (data->file_names != nullptr) sk_free(data->file_names[i]);
 		if (data->file_data  != nullptr) sk_free(data->file_data [i]);
-		if (data->color_data != nullptr) sk_free(data->color_data[i]);
+		if (data->color_data != nullptr && data->cache == nullptr) sk_free(data->color_data[i]);
+	}
+	for (int32_t i = 0; i < (int32_t)_countof(data->cache_faces); i++) {
+		sk_free(data->cache_faces[i]);
 	}
+	asset_cache_close(data->cache);
 	sk_free(data->file_names);
 	sk_free(data->file_sizes);
 	sk_free(data->file_data);
@@ -83,6 +100,55 @@ void tex_load_free(asset_header_t *, void *job_data) {
 
 ///////////////////////////////////////////
 
+// Looks for this texture's decoded images in the asset cache. This needs
+// the source files already read, since the entry is matched against their
+// contents. Only file backed textures use the cache, images from memory are
+// often generated at runtime, and would fill the cache with entries that
+// never get hit again. On a hit, color_data points into the cache entry, and
+// once the caller is happy with the entry, it can free the file data.
+bool tex_load_cache_open(tex_load_t *data, const char *kind, int32_t image_count, size_t image_size) {
+	if (!asset_cache_enabled()) return false;
+
+	data->cache_key  = hash_fnv64_string(kind);
+	data->cache_key  = hash_fnv64_data(&data->is_srgb, sizeof(data->is_srgb), data->cache_key);
+	data->cache_hash = HASH_FNV64_START;
+	for (int32_t i = 0; i < data->file_count; i++) {
+		data->cache_key  = hash_fnv64_string(data->file_names[i], data->cache_key);
+		data->cache_hash = asset_cache_hash (data->file_data[i], data->file_sizes[i], data->cache_hash);
+	}
+
+	data->cache = asset_cache_open(data->cache_key, data->cache_hash);
+	if (data->cache == nullptr) return false;
+
+	data->color_data = sk_malloc_t(void *, image_count);
+	for (int32_t i = 0; i < image_count; i++) {
+		uint64_t size = 0;
+		data->color_data[i] = (void *)asset_cache_get(data->cache, tex_cache_tag_color, i, &size);
+		if (data->color_data[i] == nullptr || size != image_size) {
+			sk_free(data->color_data);
+			asset_cache_close(data->cache);
+			data->cache = nullptr;
+			return false;
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////
+
+void tex_load_cache_write(const tex_load_t *data, void **images, int32_t image_count, size_t image_size, const spherical_harmonics_t *lighting) {
+	asset_cache_section_t *sections = sk_malloc_t(asset_cache_section_t, image_count + 1);
+	int32_t                count    = 0;
+	for (int32_t i = 0; i < image_count; i++)
+		sections[count++] = { tex_cache_tag_color, images[i], image_size };
+	if (lighting != nullptr)
+		sections[count++] = { tex_cache_tag_sh, lighting, sizeof(spherical_harmonics_t) };
+	asset_cache_write(data->cache_key, data->cache_hash, sections, count);
+	sk_free(sections);
+}
+
+///////////////////////////////////////////
+
 bool32_t tex_load_arr_files(asset_task_t *task, asset_header_t *asset, void *job_data) {
 	tex_load_t* data = (tex_load_t*)job_data;
 	tex_t       tex  = (tex_t)asset;
@@ -128,6 +194,14 @@ bool32_t tex_load_arr_files(asset_task_t *task, asset_header_t *asset, void *job
 	}
 
 	tex_set_meta(tex, width, height, format);
+
+	// Decoded images may already be waiting in the asset cache
+	if (tex_load_cache_open(data, "sk_tex", data->file_count, (size_t)width * height * tex_format_size(format))) {
+		for (int32_t i = 0; i < data->file_count; i++)
+			sk_free(data->file_data[i]);
+		assets_task_set_complexity(task, 0);
+		return true;
+	}
 	assets_task_set_complexity(task, width * height * data->file_count);
 	return true;
 }
@@ -138,6 +212,11 @@ bool32_t tex_load_arr_parse(asset_task_t *, asset_header_t *asset, void *job_dat
 	tex_load_t *data = (tex_load_t *)job_data;
 	tex_t       tex  = (tex_t)asset;
 
+	if (data->cache != nullptr) {
+		tex->header.state = asset_state_loaded_meta;
+		return true;
+	}
+
 	data->color_data = sk_malloc_t(void*, data->file_count);
 
 	// Parse all files
@@ -167,6 +246,11 @@ bool32_t tex_load_arr_parse(asset_task_t *, asset_header_t *asset, void *job_dat
 		// Release file memory as soon as we're done with it
 		sk_free(data->file_data[i]);
 	}
+
+	if (data->cache_key != 0) {
+		size_t size = (size_t)tex->width * tex->height * tex_format_size(tex->format);
+		tex_load_cache_write(data, data->color_data, data->file_count, size, nullptr);
+	}
 	tex->header.state = asset_state_loaded_meta;
 	return true;
 }
@@ -229,9 +313,25 @@ bool32_t tex_load_equirect_file(asset_task_t *task, asset_header_t *asset, void
 		return false;
 	}
 
+	// Decoding the equirect, and then sampling it into 6 faces
 	int32_t tex_size = data->color_height / 2;
 	tex_set_meta(tex, tex_size, tex_size, format);
-	assets_task_set_complexity(task, tex_size * 6);
+
+	// The converted faces and their lighting may already be in the asset
+	// cache, which skips both the decode and the conversion.
+	if (tex_load_cache_open(data, "sk_equi", 6, (size_t)tex_size * tex_size * tex_format_size(format))) {
+		uint64_t    sh_size = 0;
+		const void *sh      = asset_cache_get(data->cache, tex_cache_tag_sh, 0, &sh_size);
+		if (sh != nullptr && sh_size == sizeof(spherical_harmonics_t)) {
+			sk_free(data->file_data[0]);
+			assets_task_set_complexity(task, 0);
+			return true;
+		}
+		sk_free(data->color_data);
+		asset_cache_close(data->cache);
+		data->cache = nullptr;
+	}
+	assets_task_set_complexity(task, data->color_width * data->color_height + tex_size * tex_size * 6);
 	return true;
 }
 
@@ -241,6 +341,11 @@ bool32_t tex_load_equirect_parse(asset_task_t *, asset_header_t *asset, void *jo
 	tex_load_t *data = (tex_load_t *)job_data;
 	tex_t       tex  = (tex_t)asset;
 
+	if (data->cache != nullptr) {
+		sk_free(data->file_data[0]);
+		return true;
+	}
+
 	data->color_data = sk_malloc_t(void*, 1);
 
 	tex_format_ format = tex_format_none;
@@ -264,6 +369,14 @@ bool32_t tex_load_equirect_upload(asset_task_t *, asset_header_t *asset, void *j
 	tex_load_t *data = (tex_load_t *)job_data;
 	tex_t       tex  = (tex_t)asset;
 
+	if (data->cache != nullptr) {
+		tex->light_info  = sk_malloc_t(spherical_harmonics_t, 1);
+		*tex->light_info = *(const spherical_harmonics_t *)asset_cache_get(data->cache, tex_cache_tag_sh, 0, nullptr);
+		tex_set_color_arr(tex, tex->width, tex->height, data->color_data, 6);
+		tex->header.state = asset_state_loaded;
+		return true;
+	}
+
 	const vec3 up   [6] = { vec3_up, vec3_up, -vec3_forward, vec3_forward, vec3_up, vec3_up };
 	const vec3 fwd  [6] = { {1,0,0}, {-1,0,0}, {0,-1,0}, {0,1,0}, {0,0,1}, {0,0,-1} };
 	const vec3 right[6] = { {0,0,-1}, {0,0,1}, {1,0,0}, {1,0,0}, {1,0,0}, {-1,0,0} };
@@ -321,6 +434,14 @@ bool32_t tex_load_equirect_upload(asset_task_t *, asset_header_t *asset, void *j
 	tex_release(equirect);
 
 	tex_set_color_arr(tex, tex->width, tex->height, (void**)&face_data, 6);
+
+	// Writing the cache entry is slow, and this may be the main thread, so
+	// hand the faces off to tex_load_equirect_cache. That's also what marks
+	// the texture as loaded, so the lighting is there before anyone asks.
+	if (data->cache_key != 0) {
+		for (int32_t i = 0; i < 6; i++) data->cache_faces[i] = face_data[i];
+		return true;
+	}
 	for (int32_t i = 0; i < 6; i++) {
 		sk_free(face_data[i]);
 	}
@@ -331,6 +452,25 @@ bool32_t tex_load_equirect_upload(asset_task_t *, asset_header_t *asset, void *j
 
 ///////////////////////////////////////////
 
+bool32_t tex_load_equirect_cache(asset_task_t *, asset_header_t *asset, void *job_data) {
+	tex_load_t *data = (tex_load_t *)job_data;
+	tex_t       tex  = (tex_t)asset;
+
+	if (data->cache_faces[0] != nullptr) {
+		spherical_harmonics_t lighting = tex_faces_lighting(data->cache_faces, tex->width, tex->format);
+		tex->light_info  = sk_malloc_t(spherical_harmonics_t, 1);
+		*tex->light_info = lighting;
+
+		size_t size = (size_t)tex->width * tex->height * tex_format_size(tex->format);
+		tex_load_cache_write(data, data->cache_faces, 6, size, &lighting);
+	}
+
+	tex->header.state = asset_state_loaded;
+	return true;
+}
+
+///////////////////////////////////////////
+
 bool32_t tex_load_arr_upload(asset_task_t *, asset_header_t *asset, void *job_data) {
 	tex_load_t *data = (tex_load_t *)job_data;
 	tex_t       tex  = (tex_t)asset;
@@ -418,7 +558,8 @@ void tex_add_loading_task(tex_t texture, void *load_data, const asset_load_actio
 	task.actions      = (asset_load_action_t *)actions;
 	task.action_count = action_count;
 	task.priority     = priority;
-	task.sort         = asset_sort(priority, complexity);
+	task.complexity   = (int32_t)complexity;
+	task.sort         = asset_sort(priority, task.complexity, false);
 
 	assets_add_task(task);
 }
@@ -633,6 +774,7 @@ tex_t tex_create_cubemap_file(const char *equirectangular_file, bool32_t srgb_da
 #else
 		asset_load_action_t {tex_load_equirect_upload, asset_thread_asset},
 #endif
+		asset_load_action_t {tex_load_equirect_cache,  asset_thread_asset},
 	};
 	tex_add_loading_task(result, load_data, actions, _countof(actions), priority, 0);
 
@@ -771,12 +913,7 @@ void tex_set_fallback(tex_t texture, tex_t fallback) {
 ///////////////////////////////////////////
 
 tex_t tex_find(const char *id) {
-	tex_t result = (tex_t)assets_find(id, asset_type_tex);
-	if (result != nullptr) {
-		tex_addref(result);
-		return result;
-	}
-	return nullptr;
+	return (tex_t)assets_find_ref(id, asset_type_tex);
 }
 
 ///////////////////////////////////////////
@@ -998,6 +1135,48 @@ spherical_harmonics_t tex_get_cubemap_lighting(tex_t cubemap_texture) {
 
 ///////////////////////////////////////////
 
+// The same lighting as tex_get_cubemap_lighting, but from face data on the
+// CPU instead of reading the texture back. It works from the same size mip
+// that does, made here with a box filter.
+spherical_harmonics_t tex_faces_lighting(void **faces, int32_t size, tex_format_ format) {
+	if (format != tex_format_rgba32 && format != tex_format_rgba32_linear && format != tex_format_rgba128)
+		return {};
+
+	int32_t  mip_level = maxi((int32_t)0, (int32_t)skg_mip_count(size, size) - 6);
+	int32_t  mip_size  = maxi((int32_t)1, size >> mip_level);
+	int32_t  step      = size / mip_size;
+	size_t   px_size   = tex_format_size(format);
+	uint8_t *mip_data  = (uint8_t*)sk_malloc(px_size * mip_size * mip_size * 6);
+	void    *mips[6];
+	for (int32_t f = 0; f < 6; f++) {
+		mips[f] = mip_data + px_size * mip_size * mip_size * f;
+		for (int32_t y = 0; y < mip_size; y++) {
+			for (int32_t x = 0; x < mip_size; x++) {
+				float sum[4] = {};
+				for (int32_t sy = 0; sy < step; sy++) {
+					for (int32_t sx = 0; sx < step; sx++) {
+						uint8_t *src = (uint8_t*)faces[f] + px_size * ((size_t)(y * step + sy) * size + (x * step + sx));
+						for (int32_t c = 0; c < 4; c++)
+							sum[c] += format == tex_format_rgba128 ? ((float*)src)[c] : (float)src[c];
+					}
+				}
+				uint8_t *dest = (uint8_t*)mips[f] + px_size * ((size_t)y * mip_size + x);
+				for (int32_t c = 0; c < 4; c++) {
+					float avg = sum[c] / (step * step);
+					if (format == tex_format_rgba128) ((float*)dest)[c] = avg;
+					else                              dest[c]           = (uint8_t)(avg + 0.5f);
+				}
+			}
+		}
+	}
+
+	spherical_harmonics_t result = sh_calculate(mips, format, mip_size);
+	sk_free(mip_data);
+	return result;
+}
+
+///////////////////////////////////////////
+
 void tex_set_colors(tex_t texture, int32_t width, int32_t height, void *data) {
 	void *data_arr[1] = { data };
 	tex_set_color_arr(texture, width, height, data_arr, 1);
@@ -10,6 +10,7 @@ gcc \
  stereokit.cpp \
  stereokit_ui.cpp \
  asset_types/assets.cpp \
+ asset_types/asset_cache.cpp \
  asset_types/font.cpp \
  asset_types/material.cpp \
  asset_types/mesh.cpp \
@@ -380,8 +380,30 @@ struct hashmap_t {
 	}
 	
 	void free     ()                 { ARRAY_FREE(items); *this = {}; }
-	bool remove   (const K& key)     { int32_t at = contains(key); if (at != -1) { if (items[at].hash != 0) { count--; } items[at].hash = 0; } return at != -1; }
-	void remove_at(const int32_t at) { if (items[at].hash != 0) { count--; } items[at].hash = 0; }
+	bool remove   (const K& key)     { int32_t at = contains(key); if (at != -1) { remove_at(at); } return at != -1; }
+
+	void remove_at(const int32_t at) {
+		if (items[at].hash == 0) return;
+		count -= 1;
+		items[at].hash = 0;
+
+		// Lookups stop at the first empty slot, so anything after this that
+		// probed past it needs to shift back, or it can't be found anymore.
+		int32_t empty = at;
+		int32_t id    = at + 1 >= capacity ? 0 : at + 1;
+		while (items[id].hash != 0) {
+			int32_t home  = (int32_t)(items[id].hash % capacity);
+			bool    stays = empty <= id
+				? (home > empty && home <= id)
+				: (home > empty || home <= id);
+			if (!stays) {
+				items[empty]   = items[id];
+				items[id].hash = 0;
+				empty          = id;
+			}
+			id = id + 1 >= capacity ? 0 : id + 1;
+		}
+	}
 };
 
 //////////////////////////////////////
@@ -1,13 +1,20 @@
 #pragma once
 
+// atomic_compare_swap returns the value that was there before, so the swap
+// happened if that matches expected.
+
 #if defined(_MSC_VER)
 
 	#include <wtypes.h>
 	#include <winnt.h>
 	#define atomic_increment(int_val_ref) InterlockedIncrement((LONG*)int_val_ref)
 	#define atomic_decrement(int_val_ref) InterlockedDecrement((LONG*)int_val_ref)
+	#define atomic_read(int_val_ref) InterlockedCompareExchange((LONG*)int_val_ref, 0, 0)
+	#define atomic_compare_swap(int_val_ref, expected, desired) InterlockedCompareExchange((LONG*)int_val_ref, desired, expected)
 #else
 	// gcc and clang both implement these at least
 	#define atomic_increment(int_val_ref) __sync_add_and_fetch(int_val_ref, 1)
 	#define atomic_decrement(int_val_ref) __sync_sub_and_fetch(int_val_ref, 1)
+	#define atomic_read(int_val_ref) __atomic_load_n(int_val_ref, __ATOMIC_ACQUIRE)
+	#define atomic_compare_swap(int_val_ref, expected, desired) __sync_val_compare_and_swap(int_val_ref, expected, desired)
 #endif
\ No newline at end of file
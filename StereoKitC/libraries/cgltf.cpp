@@ -39,6 +39,13 @@ void gltf_parse_extras(model_t model, model_node_id node, const char *extras_jso
 
 	for (int32_t i = 1; i < token_ct; i+=1) {
 		if (tokens[i].type == JSMN_STRING) {
+			// MSFT_lod's screen coverage lives in extras, but it's
+			// handled by the model loader, not the node's info.
+			if (tokens[i].size == 1 && i + 1 < token_ct && tokens[i+1].type == JSMN_ARRAY &&
+				stref_equals(stref_t{ extras_json + tokens[i].start, (uint32_t)(tokens[i].end - tokens[i].start) }, "MSFT_screencoverage")) {
+				i += 1 + tokens[i+1].size;
+				continue;
+			}
 			if (tokens[i].size == 1) {
 				stref_t key     = { extras_json + tokens[i  ].start, (uint32_t)(tokens[i  ].end-tokens[i  ].start) };
 				stref_t val     = { extras_json + tokens[i+1].start, (uint32_t)(tokens[i+1].end-tokens[i+1].start) };
@@ -63,4 +70,48 @@ void gltf_parse_extras(model_t model, model_node_id node, const char *extras_jso
 	sk_free(tokens);
 }
 
+///////////////////////////////////////////
+
+int32_t gltf_parse_number_array(const char *json, const char *key, float *out_values, int32_t max_values) {
+	size_t      json_size = strlen(json);
+	jsmn_parser parser;
+	jsmn_init(&parser);
+
+	int32_t token_ct = jsmn_parse(&parser, json, json_size, nullptr, 0);
+	if (token_ct <= 0) return 0;
+
+	jsmntok_t* tokens = sk_malloc_t(jsmntok_t, token_ct);
+	jsmn_init(&parser);
+	token_ct = jsmn_parse(&parser, json, json_size, tokens, token_ct);
+
+	int32_t result = 0;
+	if (token_ct > 0 && tokens[0].type == JSMN_OBJECT) {
+		// Only looks at the top level keys of the object
+		for (int32_t i = 1; i + 1 < token_ct; i += 1) {
+			bool match = tokens[i].type == JSMN_STRING && tokens[i].size == 1 &&
+				stref_equals(stref_t{ json + tokens[i].start, (uint32_t)(tokens[i].end - tokens[i].start) }, key);
+			if (match && tokens[i+1].type == JSMN_ARRAY) {
+				int32_t count = tokens[i+1].size;
+				for (int32_t v = 0; v < count && v < max_values && i + 2 + v < token_ct; v++) {
+					const jsmntok_t *tok = &tokens[i + 2 + v];
+					if (tok->type != JSMN_PRIMITIVE) break;
+					char num[32] = {};
+					int32_t len = tok->end - tok->start < (int32_t)sizeof(num) - 1 ? tok->end - tok->start : (int32_t)sizeof(num) - 1;
+					memcpy(num, json + tok->start, len);
+					out_values[result++] = (float)atof(num);
+				}
+				break;
+			}
+			// Skip over this key's value
+			if (tokens[i].size == 1) {
+				int32_t end = tokens[i+1].end;
+				i += 1;
+				while (i + 1 < token_ct && tokens[i+1].start < end) i++;
+			}
+		}
+	}
+	sk_free(tokens);
+	return result;
+}
+
 }
\ No newline at end of file
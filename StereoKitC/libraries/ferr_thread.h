@@ -62,6 +62,7 @@ ft_thread_t    ft_thread_current     (void);
 void           fr_thread_name        (ft_thread_t thread, const char* name);
 
 void           ft_yield              (void);
+int32_t        ft_processor_count    (void);
 
 ///////////////////////////////////////////
 
@@ -84,6 +85,7 @@ void           ft_yield              (void);
 #else
 
 	#include <pthread.h>
+	#include <unistd.h>
 	struct _ft_mutex_t {
 		pthread_mutex_t mutex;
 	};
@@ -336,4 +338,17 @@ void ft_yield(void) {
 #endif
 }
 
+///////////////////////////////////////////
+
+int32_t ft_processor_count(void) {
+#if defined(FT_WIN)
+	SYSTEM_INFO info = {};
+	GetSystemInfo(&info);
+	return (int32_t)info.dwNumberOfProcessors;
+#else
+	long result = sysconf(_SC_NPROCESSORS_ONLN);
+	return result > 0 ? (int32_t)result : 1;
+#endif
+}
+
 #endif // FERR_THREAD_IMPL
\ No newline at end of file
@@ -227,6 +227,8 @@ typedef enum skg_log_ {
 typedef enum skg_cap_ {
 	skg_cap_tex_layer_select = 1,
 	skg_cap_wireframe,
+	skg_cap_buffer_bind_range,
+	skg_cap_gpu_timer,
 } skg_cap_;
 
 typedef struct {
@@ -382,6 +384,20 @@ typedef struct skg_tex_t {
 	ID3D11DepthStencilView    *_depth_view;
 } skg_tex_t;
 
+typedef struct skg_readback_t {
+	int32_t                    width;
+	int32_t                    height;
+	skg_tex_fmt_               format;
+	ID3D11Texture2D           *_staging;
+	ID3D11Query               *_event;
+} skg_readback_t;
+
+typedef struct skg_timer_t {
+	ID3D11Query               *_disjoint;
+	ID3D11Query               *_start;
+	ID3D11Query               *_end;
+} skg_timer_t;
+
 typedef struct skg_swapchain_t {
 	int32_t          width;
 	int32_t          height;
@@ -462,6 +478,20 @@ typedef struct skg_tex_t {
 	uint32_t      _format;
 } skg_tex_t;
 
+typedef struct skg_readback_t {
+	int32_t       width;
+	int32_t       height;
+	skg_tex_fmt_  format;
+	uint32_t      _buffer;
+	void         *_fence;
+	void         *_data; // WebGL can't map buffers, so web reads here directly
+} skg_readback_t;
+
+typedef struct skg_timer_t {
+	uint32_t      _start;
+	uint32_t      _end;
+} skg_timer_t;
+
 typedef struct skg_swapchain_t {
 	int32_t  width;
 	int32_t  height;
@@ -550,6 +580,15 @@ typedef struct skg_tex_t {
 	skg_mip_           mips;
 } skg_tex_t;
 
+typedef struct skg_readback_t {
+	int32_t            width;
+	int32_t            height;
+	skg_tex_fmt_       format;
+} skg_readback_t;
+
+typedef struct skg_timer_t {
+} skg_timer_t;
+
 typedef struct skg_swapchain_t {
 	int32_t            width;
 	int32_t            height;
@@ -585,6 +624,7 @@ SKG_API bool                skg_buffer_is_valid          (const skg_buffer_t *bu
 SKG_API void                skg_buffer_set_contents      (      skg_buffer_t *buffer, const void *data, uint32_t size_bytes);
 SKG_API void                skg_buffer_get_contents      (const skg_buffer_t *buffer, void *ref_buffer, uint32_t buffer_size);
 SKG_API void                skg_buffer_bind              (const skg_buffer_t *buffer, skg_bind_t slot_vc, uint32_t offset_vi);
+SKG_API void                skg_buffer_bind_range        (const skg_buffer_t *buffer, skg_bind_t slot_vc, uint32_t offset_bytes, uint32_t size_bytes);
 SKG_API void                skg_buffer_clear             (      skg_bind_t bind);
 SKG_API void                skg_buffer_destroy           (      skg_buffer_t *buffer);
 
@@ -658,6 +698,21 @@ SKG_API int64_t             skg_tex_fmt_to_native        (skg_tex_fmt_ format);
 SKG_API skg_tex_fmt_        skg_tex_fmt_from_native      (int64_t      format);
 SKG_API uint32_t            skg_tex_fmt_size             (skg_tex_fmt_ format);
 
+SKG_API skg_readback_t      skg_readback_create          (skg_tex_fmt_ format, int32_t width, int32_t height);
+SKG_API bool                skg_readback_is_valid        (const skg_readback_t *readback);
+SKG_API bool                skg_readback_start           (      skg_readback_t *readback, const skg_tex_t *tex);
+SKG_API bool                skg_readback_ready           (      skg_readback_t *readback);
+SKG_API bool                skg_readback_get_contents    (      skg_readback_t *readback, void *ref_data, size_t data_size);
+SKG_API void                skg_readback_destroy         (      skg_readback_t *readback);
+
+SKG_API skg_timer_t         skg_timer_create             ();
+SKG_API bool                skg_timer_is_valid           (const skg_timer_t *timer);
+SKG_API void                skg_timer_begin              (      skg_timer_t *timer);
+SKG_API void                skg_timer_end                (      skg_timer_t *timer);
+SKG_API bool                skg_timer_ready              (      skg_timer_t *timer);
+SKG_API bool                skg_timer_get_ms             (      skg_timer_t *timer, float *out_ms);
+SKG_API void                skg_timer_destroy            (      skg_timer_t *timer);
+
 
 ///////////////////////////////////////////
 // API independant functions             //
@@ -744,7 +799,7 @@ SKG_API void                    skg_shader_meta_release        (skg_shader_meta_
 #define WIN32_LEAN_AND_MEAN
 #endif
 
-#include <d3d11.h>
+#include <d3d11_1.h>
 #include <dxgi1_6.h>
 
 #if !defined(SKG_NO_D3DCOMPILER)
@@ -762,6 +817,7 @@ const GUID WKPDID_D3DDebugObjectName = { 0x429b8c22, 0x9188, 0x4b0c, { 0x87,0x42
 
 ID3D11Device            *d3d_device      = nullptr;
 ID3D11DeviceContext     *d3d_context     = nullptr;
+ID3D11DeviceContext1    *d3d_context1    = nullptr;
 ID3D11InfoQueue         *d3d_info        = nullptr;
 ID3D11RasterizerState   *d3d_rasterstate = nullptr;
 ID3D11DepthStencilState *d3d_depthstate  = nullptr;
@@ -852,6 +908,12 @@ int32_t skg_init(const char *, void *adapter_id) {
 		return 0;
 	}
 
+	// Direct3D 11.1 contexts can bind constant buffers at an offset, which
+	// is optional, so this may be null on older runtimes.
+	if (FAILED(d3d_context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&d3d_context1))) {
+		d3d_context1 = nullptr;
+	}
+
 	// Create a deferred context for making some multithreaded context calls.
 	hr = d3d_device->CreateDeferredContext(0, &d3d_deferred);
 	if (FAILED(hr)) {
@@ -943,6 +1005,7 @@ void skg_shutdown() {
 	if (d3d_depthstate ) { d3d_depthstate ->Release(); d3d_depthstate  = nullptr; }
 	if (d3d_info       ) { d3d_info       ->Release(); d3d_info        = nullptr; }
 	if (d3d_deferred   ) { d3d_deferred   ->Release(); d3d_deferred    = nullptr; }
+	if (d3d_context1   ) { d3d_context1   ->Release(); d3d_context1    = nullptr; }
 	if (d3d_context    ) { d3d_context    ->Release(); d3d_context     = nullptr; }
 	if (d3d_device     ) { d3d_device     ->Release(); d3d_device      = nullptr; }
 }
@@ -983,6 +1046,13 @@ bool skg_capability(skg_cap_ capability) {
 		return options.VPAndRTArrayIndexFromAnyShaderFeedingRasterizer;
 	} break;
 	case skg_cap_wireframe: return true;
+	case skg_cap_buffer_bind_range: {
+		if (d3d_context1 == nullptr) return false;
+		D3D11_FEATURE_DATA_D3D11_OPTIONS options;
+		d3d_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options));
+		return options.ConstantBufferOffsetting;
+	} break;
+	case skg_cap_gpu_timer: return true;
 	default: return false;
 	}
 }
@@ -1269,6 +1339,26 @@ void skg_buffer_bind(const skg_buffer_t *buffer, skg_bind_t bind, uint32_t offse
 
 ///////////////////////////////////////////
 
+void skg_buffer_bind_range(const skg_buffer_t *buffer, skg_bind_t bind, uint32_t offset_bytes, uint32_t size_bytes) {
+	if (bind.register_type != skg_register_constant || d3d_context1 == nullptr) {
+		skg_buffer_bind(buffer, bind, 0);
+		return;
+	}
+#if !defined(NDEBUG)
+	if (buffer->type != skg_buffer_type_constant) skg_log(skg_log_critical, "Attempting to bind the wrong buffer type to a constant register! Use skg_buffer_type_constant");
+	if (offset_bytes % 256 != 0 || size_bytes % 256 != 0) skg_log(skg_log_critical, "Constant buffer ranges must be 256 byte aligned!");
+#endif
+
+	// D3D11.1 measures constant buffer ranges in 16 byte shader constants
+	UINT first = offset_bytes / 16;
+	UINT count = size_bytes   / 16;
+	if (bind.stage_bits & skg_stage_vertex ) d3d_context1->VSSetConstantBuffers1(bind.slot, 1, &buffer->_buffer, &first, &count);
+	if (bind.stage_bits & skg_stage_pixel  ) d3d_context1->PSSetConstantBuffers1(bind.slot, 1, &buffer->_buffer, &first, &count);
+	if (bind.stage_bits & skg_stage_compute) d3d_context1->CSSetConstantBuffers1(bind.slot, 1, &buffer->_buffer, &first, &count);
+}
+
+///////////////////////////////////////////
+
 void skg_buffer_destroy(skg_buffer_t *buffer) {
 	if (buffer->_buffer) buffer->_buffer->Release();
 	*buffer = {};
@@ -2529,6 +2619,174 @@ void skg_tex_destroy(skg_tex_t *tex) {
 
 ///////////////////////////////////////////
 
+skg_readback_t skg_readback_create(skg_tex_fmt_ format, int32_t width, int32_t height) {
+	skg_readback_t result = {};
+	result.width  = width;
+	result.height = height;
+	result.format = format;
+
+	D3D11_TEXTURE2D_DESC desc = {};
+	desc.Width            = width;
+	desc.Height           = height;
+	desc.MipLevels        = 1;
+	desc.ArraySize        = 1;
+	desc.SampleDesc.Count = 1;
+	desc.Format           = (DXGI_FORMAT)skg_tex_fmt_to_native(format);
+	desc.Usage            = D3D11_USAGE_STAGING;
+	desc.CPUAccessFlags   = D3D11_CPU_ACCESS_READ;
+	HRESULT hr = d3d_device->CreateTexture2D(&desc, nullptr, &result._staging);
+	if (FAILED(hr)) {
+		skg_logf(skg_log_critical, "skg_readback_create staging texture failed: 0x%08X", hr);
+		return result;
+	}
+
+	D3D11_QUERY_DESC query_desc = {};
+	query_desc.Query = D3D11_QUERY_EVENT;
+	hr = d3d_device->CreateQuery(&query_desc, &result._event);
+	if (FAILED(hr)) {
+		skg_logf(skg_log_critical, "skg_readback_create query failed: 0x%08X", hr);
+		result._staging->Release();
+		result._staging = nullptr;
+	}
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_is_valid(const skg_readback_t *readback) {
+	return readback->_staging != nullptr;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_start(skg_readback_t *readback, const skg_tex_t *tex) {
+	if (tex->multisample > 1 || tex->width != readback->width || tex->height != readback->height || tex->format != readback->format) {
+		skg_log(skg_log_critical, "skg_readback_start needs a single sample texture with the same size and format as the readback");
+		return false;
+	}
+
+	D3D11_BOX box = {};
+	box.right  = tex->width;
+	box.bottom = tex->height;
+	box.back   = 1;
+	d3d_context->CopySubresourceRegion(readback->_staging, 0, 0, 0, 0, tex->_texture, 0, &box);
+	d3d_context->End(readback->_event);
+	return true;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_ready(skg_readback_t *readback) {
+	return d3d_context->GetData(readback->_event, nullptr, 0, 0) == S_OK;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_get_contents(skg_readback_t *readback, void *ref_data, size_t data_size) {
+	size_t line_size = (size_t)readback->width * skg_tex_fmt_size(readback->format);
+	if (data_size != line_size * readback->height) {
+		skg_log(skg_log_critical, "Insufficient buffer size for skg_readback_get_contents");
+		return false;
+	}
+
+	// This will wait on the GPU if the copy isn't finished yet
+	D3D11_MAPPED_SUBRESOURCE data;
+	HRESULT hr = d3d_context->Map(readback->_staging, 0, D3D11_MAP_READ, 0, &data);
+	if (FAILED(hr)) {
+		skg_logf(skg_log_critical, "Readback Map failed: 0x%08X", hr);
+		return false;
+	}
+
+	uint8_t *src  = (uint8_t*)data.pData;
+	uint8_t *dest = (uint8_t*)ref_data;
+	for (int32_t y = 0; y < readback->height; y++) {
+		memcpy(dest, src, line_size);
+		src  += data.RowPitch;
+		dest += line_size;
+	}
+	d3d_context->Unmap(readback->_staging, 0);
+	return true;
+}
+
+///////////////////////////////////////////
+
+void skg_readback_destroy(skg_readback_t *readback) {
+	if (readback->_event  ) readback->_event  ->Release();
+	if (readback->_staging) readback->_staging->Release();
+	*readback = {};
+}
+
+///////////////////////////////////////////
+
+skg_timer_t skg_timer_create() {
+	skg_timer_t result = {};
+
+	D3D11_QUERY_DESC disjoint_desc = {};
+	D3D11_QUERY_DESC stamp_desc    = {};
+	disjoint_desc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+	stamp_desc   .Query = D3D11_QUERY_TIMESTAMP;
+	HRESULT hr = d3d_device->CreateQuery(&disjoint_desc, &result._disjoint);
+	if (SUCCEEDED(hr)) hr = d3d_device->CreateQuery(&stamp_desc, &result._start);
+	if (SUCCEEDED(hr)) hr = d3d_device->CreateQuery(&stamp_desc, &result._end);
+	if (FAILED(hr)) {
+		skg_logf(skg_log_critical, "skg_timer_create query failed: 0x%08X", hr);
+		skg_timer_destroy(&result);
+	}
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_is_valid(const skg_timer_t *timer) {
+	return timer->_end != nullptr;
+}
+
+///////////////////////////////////////////
+
+void skg_timer_begin(skg_timer_t *timer) {
+	d3d_context->Begin(timer->_disjoint);
+	d3d_context->End  (timer->_start);
+}
+
+///////////////////////////////////////////
+
+void skg_timer_end(skg_timer_t *timer) {
+	d3d_context->End(timer->_end);
+	d3d_context->End(timer->_disjoint);
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_ready(skg_timer_t *timer) {
+	return d3d_context->GetData(timer->_disjoint, nullptr, 0, D3D11_ASYNC_GETDATA_DONOTFLUSH) == S_OK;
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_get_ms(skg_timer_t *timer, float *out_ms) {
+	// This never waits on the GPU, so it fails if the timer isn't ready, or
+	// if something like a clock change made the timestamps meaningless.
+	D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint = {};
+	uint64_t start = 0, end = 0;
+	if (d3d_context->GetData(timer->_disjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK || disjoint.Disjoint || disjoint.Frequency == 0) return false;
+	if (d3d_context->GetData(timer->_start,    &start,    sizeof(start),    D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) return false;
+	if (d3d_context->GetData(timer->_end,      &end,      sizeof(end),      D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) return false;
+
+	*out_ms = (float)((double)(end - start) * 1000.0 / (double)disjoint.Frequency);
+	return true;
+}
+
+///////////////////////////////////////////
+
+void skg_timer_destroy(skg_timer_t *timer) {
+	if (timer->_disjoint) timer->_disjoint->Release();
+	if (timer->_start   ) timer->_start   ->Release();
+	if (timer->_end     ) timer->_end     ->Release();
+	*timer = {};
+}
+
+///////////////////////////////////////////
+
 template <typename T>
 void skg_downsample_4(T *data, T data_max, int32_t width, int32_t height, T **out_data, int32_t *out_width, int32_t *out_height) {
 	*out_width  = width  / 2;
@@ -2794,6 +3052,18 @@ const char *skg_semantic_to_d3d(skg_el_semantic_ semantic) {
 #define GL_ARRAY_BUFFER 0x8892
 #define GL_ELEMENT_ARRAY_BUFFER 0x8893
 #define GL_UNIFORM_BUFFER 0x8A11
+#define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#define GL_PIXEL_PACK_BUFFER 0x88EB
+#define GL_STREAM_READ 0x88E1
+#define GL_MAP_READ_BIT 0x0001
+#define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#define GL_ALREADY_SIGNALED 0x911A
+#define GL_CONDITION_SATISFIED 0x911C
+#define GL_TIMESTAMP 0x8E28
+#define GL_QUERY_RESULT 0x8866
+#define GL_QUERY_RESULT_AVAILABLE 0x8867
+#define GL_GPU_DISJOINT_EXT 0x8FBB
 #define GL_SHADER_STORAGE_BUFFER 0x90D2
 #define GL_STATIC_DRAW 0x88E4
 #define GL_DYNAMIC_DRAW 0x88E8
@@ -3022,7 +3292,18 @@ GLE(void,     glDrawElementsInstancedBaseVertex,   uint32_t mode, int32_t count,
 GLE(void,     glDrawElements,            uint32_t mode, int32_t count, uint32_t type, const void *indices) \
 GLE(void,     glDebugMessageCallback,    GLDEBUGPROC callback, const void *userParam) \
 GLE(void,     glBindBufferBase,          uint32_t target, uint32_t index, uint32_t buffer) \
+GLE(void,     glBindBufferRange,         uint32_t target, uint32_t index, uint32_t buffer, int64_t offset, int64_t size) \
 GLE(void,     glBufferSubData,           uint32_t target, int64_t offset, int32_t size, const void *data) \
+GLE(void *,   glMapBufferRange,          uint32_t target, int64_t offset, int64_t length, uint32_t access) \
+GLE(uint8_t,  glUnmapBuffer,             uint32_t target) \
+GLE(void *,   glFenceSync,               uint32_t condition, uint32_t flags) \
+GLE(uint32_t, glClientWaitSync,          void *sync, uint32_t flags, uint64_t timeout) \
+GLE(void,     glDeleteSync,              void *sync) \
+GLE(void,     glGenQueries,              int32_t n, uint32_t *ids) \
+GLE(void,     glDeleteQueries,           int32_t n, const uint32_t *ids) \
+GLE(void,     glQueryCounter,            uint32_t id, uint32_t target) \
+GLE(void,     glGetQueryObjectuiv,       uint32_t id, uint32_t pname, uint32_t *params) \
+GLE(void,     glGetQueryObjectui64v,     uint32_t id, uint32_t pname, uint64_t *params) \
 GLE(void,     glViewport,                int32_t x, int32_t y, uint32_t width, uint32_t height) \
 GLE(void,     glScissor,                 int32_t x, int32_t y, uint32_t width, uint32_t height) \
 GLE(void,     glCullFace,                uint32_t mode) \
@@ -3060,6 +3341,11 @@ static void gl_load_extensions( ) {
 #define GLE(ret, name, ...) name = (name##_proc *) gl_get_function(#name); if (name == nullptr) skg_log(skg_log_info, "Couldn't load gl function " #name);
 	GL_API
 #undef GLE
+#if defined(_SKG_GL_ES)
+	// GLES only has timestamps through GL_EXT_disjoint_timer_query
+	if (glQueryCounter        == nullptr) glQueryCounter        = (glQueryCounter_proc        *) gl_get_function("glQueryCounterEXT");
+	if (glGetQueryObjectui64v == nullptr) glGetQueryObjectui64v = (glGetQueryObjectui64v_proc *) gl_get_function("glGetQueryObjectui64vEXT");
+#endif
 }
 
 #endif // _SKG_GL_MAKE_FUNCTIONS
@@ -3556,6 +3842,21 @@ bool skg_capability(skg_cap_ capability) {
 #pragma clang diagnostic ignored "-Wtautological-pointer-compare"
 		return glPolygonMode != nullptr;
 #pragma clang diagnostic pop
+#endif
+	case skg_cap_buffer_bind_range: {
+		// Callers align ranges to 256 bytes, which matches D3D11.1
+		int32_t alignment = 0;
+		glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+		return alignment > 0 && 256 % alignment == 0;
+	} break;
+	case skg_cap_gpu_timer:
+#if defined(_SKG_GL_WEB)
+		return false;
+#else
+	#if defined(_SKG_GL_ES)
+		if (!check_ext("GL_EXT_disjoint_timer_query")) return false;
+	#endif
+		return glQueryCounter != nullptr && glGetQueryObjectui64v != nullptr;
 #endif
 	default: return false;
 	}
@@ -3655,6 +3956,15 @@ void skg_buffer_bind(const skg_buffer_t *buffer, skg_bind_t bind, uint32_t offse
 
 ///////////////////////////////////////////
 
+void skg_buffer_bind_range(const skg_buffer_t *buffer, skg_bind_t bind, uint32_t offset_bytes, uint32_t size_bytes) {
+	if (buffer->type == skg_buffer_type_constant || buffer->type == skg_buffer_type_compute)
+		glBindBufferRange(buffer->_target, bind.slot, buffer->_buffer, offset_bytes, size_bytes);
+	else
+		skg_buffer_bind(buffer, bind, offset_bytes);
+}
+
+///////////////////////////////////////////
+
 void skg_buffer_clear(skg_bind_t bind) {
 	if (bind.stage_bits == skg_stage_compute) {
 		if (bind.register_type == skg_register_constant)
@@ -4701,6 +5011,207 @@ void skg_tex_destroy(skg_tex_t *tex) {
 
 ///////////////////////////////////////////
 
+skg_readback_t skg_readback_create(skg_tex_fmt_ format, int32_t width, int32_t height) {
+	skg_readback_t result = {};
+	result.width  = width;
+	result.height = height;
+	result.format = format;
+
+	size_t size = (size_t)width * height * skg_tex_fmt_size(format);
+#if defined(_SKG_GL_WEB)
+	result._data = malloc(size);
+#else
+	glGenBuffers(1, &result._buffer);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, result._buffer);
+	glBufferData(GL_PIXEL_PACK_BUFFER, (int32_t)size, nullptr, GL_STREAM_READ);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+#endif
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_is_valid(const skg_readback_t *readback) {
+	return readback->_buffer != 0 || readback->_data != nullptr;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_start(skg_readback_t *readback, const skg_tex_t *tex) {
+	if (tex->multisample > 1 || tex->width != readback->width || tex->height != readback->height || tex->format != readback->format) {
+		skg_log(skg_log_critical, "skg_readback_start needs a single sample texture with the same size and format as the readback");
+		return false;
+	}
+
+	uint32_t fbo = 0;
+	glGenFramebuffers     (1, &fbo);
+	glBindFramebuffer     (GL_FRAMEBUFFER, fbo);
+	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, tex->_target, tex->_texture, 0);
+
+#if defined(_SKG_GL_WEB)
+	// No async path here, so this is read right away
+	glReadPixels(0, 0, tex->width, tex->height, (uint32_t)skg_tex_fmt_to_gl_layout(tex->format), skg_tex_fmt_to_gl_type(tex->format), readback->_data);
+#else
+	// Reading into a pack buffer returns right away, and the fence lets us
+	// know when the GPU has actually filled it.
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->_buffer);
+	glReadPixels(0, 0, tex->width, tex->height, (uint32_t)skg_tex_fmt_to_gl_layout(tex->format), skg_tex_fmt_to_gl_type(tex->format), nullptr);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	if (readback->_fence) glDeleteSync(readback->_fence);
+	readback->_fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+#endif
+
+	glBindFramebuffer   (GL_FRAMEBUFFER, gl_current_framebuffer);
+	glDeleteFramebuffers(1, &fbo);
+	return true;
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_ready(skg_readback_t *readback) {
+#if defined(_SKG_GL_WEB)
+	return true;
+#else
+	if (readback->_fence == nullptr) return true;
+	uint32_t result = glClientWaitSync(readback->_fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+#endif
+}
+
+///////////////////////////////////////////
+
+bool skg_readback_get_contents(skg_readback_t *readback, void *ref_data, size_t data_size) {
+	size_t size = (size_t)readback->width * readback->height * skg_tex_fmt_size(readback->format);
+	if (data_size != size) {
+		skg_log(skg_log_critical, "Insufficient buffer size for skg_readback_get_contents");
+		return false;
+	}
+
+#if defined(_SKG_GL_WEB)
+	memcpy(ref_data, readback->_data, size);
+	return true;
+#else
+	// This will wait on the GPU if the copy isn't finished yet
+	if (readback->_fence) {
+		glClientWaitSync(readback->_fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+		glDeleteSync(readback->_fence);
+		readback->_fence = nullptr;
+	}
+
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->_buffer);
+	void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+	if (data != nullptr) {
+		memcpy(ref_data, data, size);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	if (data == nullptr) {
+		skg_log(skg_log_critical, "skg_readback_get_contents couldn't map the pack buffer");
+		return false;
+	}
+	return true;
+#endif
+}
+
+///////////////////////////////////////////
+
+void skg_readback_destroy(skg_readback_t *readback) {
+#if defined(_SKG_GL_WEB)
+	free(readback->_data);
+#else
+	if (readback->_fence ) glDeleteSync   (readback->_fence);
+	if (readback->_buffer) glDeleteBuffers(1, &readback->_buffer);
+#endif
+	*readback = {};
+}
+
+///////////////////////////////////////////
+
+// WebGL's timer queries work differently enough that they aren't supported
+// here, so timers on web are never valid.
+
+skg_timer_t skg_timer_create() {
+	skg_timer_t result = {};
+#if !defined(_SKG_GL_WEB)
+	if (!skg_capability(skg_cap_gpu_timer)) return result;
+	uint32_t ids[2] = {};
+	glGenQueries(2, ids);
+	result._start = ids[0];
+	result._end   = ids[1];
+#endif
+	return result;
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_is_valid(const skg_timer_t *timer) {
+	return timer->_end != 0;
+}
+
+///////////////////////////////////////////
+
+void skg_timer_begin(skg_timer_t *timer) {
+#if !defined(_SKG_GL_WEB)
+	glQueryCounter(timer->_start, GL_TIMESTAMP);
+#endif
+}
+
+///////////////////////////////////////////
+
+void skg_timer_end(skg_timer_t *timer) {
+#if !defined(_SKG_GL_WEB)
+	glQueryCounter(timer->_end, GL_TIMESTAMP);
+#endif
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_ready(skg_timer_t *timer) {
+#if defined(_SKG_GL_WEB)
+	return false;
+#else
+	uint32_t available = 0;
+	glGetQueryObjectuiv(timer->_end, GL_QUERY_RESULT_AVAILABLE, &available);
+	return available != 0;
+#endif
+}
+
+///////////////////////////////////////////
+
+bool skg_timer_get_ms(skg_timer_t *timer, float *out_ms) {
+#if defined(_SKG_GL_WEB)
+	return false;
+#else
+	// This never waits on the GPU, so it fails if the timer isn't ready, or
+	// if the GPU reports that its timestamps were disrupted.
+	if (!skg_timer_ready(timer)) return false;
+	#if defined(_SKG_GL_ES)
+	int32_t disjoint = 0;
+	glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+	if (disjoint) return false;
+	#endif
+
+	uint64_t start = 0, end = 0;
+	glGetQueryObjectui64v(timer->_start, GL_QUERY_RESULT, &start);
+	glGetQueryObjectui64v(timer->_end,   GL_QUERY_RESULT, &end);
+	*out_ms = (float)((double)(end - start) / 1000000.0);
+	return true;
+#endif
+}
+
+///////////////////////////////////////////
+
+void skg_timer_destroy(skg_timer_t *timer) {
+#if !defined(_SKG_GL_WEB)
+	uint32_t ids[2] = { timer->_start, timer->_end };
+	if (timer->_end) glDeleteQueries(2, ids);
+#endif
+	*timer = {};
+}
+
+///////////////////////////////////////////
+
 uint32_t skg_buffer_type_to_gl(skg_buffer_type_ type) {
 	switch (type) {
 	case skg_buffer_type_vertex:   return GL_ARRAY_BUFFER;
@@ -4,8 +4,10 @@
 
 #include "../_stereokit.h"
 #include "../log.h"
+#include "../asset_types/assets.h"
 #include "../libraries/stref.h"
 #include "../systems/input.h"
+#include "../systems/render.h"
 #include "win32.h"
 #include "uwp.h"
 #include "linux.h"
@@ -90,6 +92,10 @@ bool platform_init() {
 ///////////////////////////////////////////
 
 void platform_shutdown() {
+	// Nothing will be drawn past this point, so assets waiting on the end of
+	// a frame can go now, while there's still a GPU to release them from.
+	assets_frame_end(true);
+
 	platform_utils_shutdown();
 	platform_stop_mode();
 	skg_shutdown();
@@ -250,7 +256,13 @@ void platform_step_begin() {
 
 void platform_step_end() {
 	switch (device_data.display_type) {
-	case display_type_none: break;
+	case display_type_none:
+		// Nothing goes to a display, but render targets and screenshots
+		// still get drawn, and the frame's render lists still need to let
+		// go of what was queued.
+		render_draw_offscreen();
+		render_clear();
+		break;
 	case display_type_stereo:
 #if defined(SK_XR_OPENXR)
 		openxr_step_end();
@@ -458,6 +458,12 @@ void sk_step_timer() {
 
 ///////////////////////////////////////////
 
+bool32_t sk_is_main_thread() {
+	return ft_id_matches(local.init_thread);
+}
+
+///////////////////////////////////////////
+
 void sk_assert_thread_valid() {
 	// sk_init and sk_run/step need to happen on the same thread, but there's a
 	// non-zero chance that some async code can inadvertently put execution
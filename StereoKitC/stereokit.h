@@ -427,6 +427,10 @@ SK_API bool32_t      sk_is_stepping        (void);
 SK_API display_mode_ sk_active_display_mode(void);
 SK_API sk_settings_t sk_get_settings       (void);
 SK_API system_info_t sk_system_info        (void);
+SK_API int32_t       sk_profile_system_count   (void);
+SK_API const char   *sk_profile_system_name    (int32_t system_index);
+SK_API double        sk_profile_system_total_ms(int32_t system_index);
+SK_API uint64_t      sk_profile_system_steps   (int32_t system_index);
 SK_API const char   *sk_version_name       (void);
 SK_API uint64_t      sk_version_id         (void);
 SK_API app_focus_    sk_app_focus          (void);
@@ -1453,6 +1457,9 @@ SK_API void          model_node_set_solid          (model_t model, model_node_id
 SK_API void          model_node_set_visible        (model_t model, model_node_id node, bool32_t    visible);
 SK_API void          model_node_set_material       (model_t model, model_node_id node, material_t  material);
 SK_API void          model_node_set_mesh           (model_t model, model_node_id node, mesh_t      mesh);
+SK_API void          model_node_add_lod            (model_t model, model_node_id node, mesh_t mesh, material_t material, float screen_coverage);
+SK_API int32_t       model_node_lod_count          (model_t model, model_node_id node);
+SK_API void          model_node_clear_lods         (model_t model, model_node_id node);
 SK_API void          model_node_set_transform_model(model_t model, model_node_id node, matrix      transform_model_space);
 SK_API void          model_node_set_transform_local(model_t model, model_node_id node, matrix      transform_local_space);
 SK_API const char*   model_node_info_get           (model_t model, model_node_id node, const char* info_key_utf8);
@@ -1529,6 +1536,124 @@ typedef enum render_clear_ {
 	render_clear_all   = render_clear_color | render_clear_depth,
 } render_clear_;
 
+/*How StereoKit orders draws within a range of render queue positions.
+  A Material's queue position is based on its transparency mode (1000 for
+  opaque, 2000 for blend, 3000 for add) plus its queue offset. Distances
+  are measured from the primary camera.*/
+typedef enum render_sort_ {
+	/*Sort by Material and Mesh first to keep state changes to a minimum,
+	  and then front to back. This is the default for opaque and additive
+	  queues.*/
+	render_sort_state_first = 0,
+	/*Sort front to back first, and then by Material and Mesh. This gets
+	  the most out of early depth rejection, at the cost of more state
+	  changes.*/
+	render_sort_depth_first,
+	/*Sort strictly back to front, and then by Material and Mesh. This is
+	  the default for blended queues, as blending needs far objects drawn
+	  before near ones.*/
+	render_sort_back_to_front,
+} render_sort_;
+
+/*The groups of GPU work that StereoKit times separately, see
+  render_stats_gpu_ms. The primary passes are split up by Material queue
+  position, the same ranges render_set_sort uses by default.*/
+typedef enum render_pass_ {
+	/*The primary view's opaque queue, everything before 2000 except the
+	  sky.*/
+	render_pass_opaque = 0,
+	/*The skybox, drawn in the middle of the opaque queue.*/
+	render_pass_sky,
+	/*The primary view's blend queue, from 2000 up to 3000.*/
+	render_pass_blend,
+	/*The primary view's additive queue, and anything queued after it.*/
+	render_pass_add,
+	/*Everything drawn for render_to and render_material_to.*/
+	render_pass_viewpoint,
+	/*Everything drawn for screenshots.*/
+	render_pass_screenshot,
+	/*Everything drawn by render_blit.*/
+	render_pass_blit,
+	/*The number of passes, not a pass itself.*/
+	render_pass_max,
+} render_pass_;
+
+/*Counts of what the renderer did over the most recently finished frame,
+  across the primary display and any render_to or screenshot views.*/
+typedef struct render_frame_stats_t {
+	int32_t draw_calls;
+	int32_t draw_instances;
+	int32_t swaps_mesh;
+	int32_t swaps_material;
+	int32_t swaps_texture;
+	int32_t culled;
+	int32_t occluded;
+	int32_t instance_ring_size;
+	int32_t instance_ring_stalls;
+	int32_t target_pool_hits;
+	int32_t target_pool_misses;
+	/*Model visuals drawn at each LOD, where 0 is full detail. The last
+	  entry also counts anything past it.*/
+	int32_t lod_draws[8];
+} render_frame_stats_t;
+
+/*What the dynamic resolution governor did with the render scaling on
+  its most recent frame. See render_governor_get_decision.*/
+typedef enum render_governor_ {
+	/*The governor is off, and render scaling is left entirely to the
+	  application.*/
+	render_governor_disabled = 0,
+	/*The scaling was left alone, see render_governor_reason_ for why.*/
+	render_governor_hold,
+	/*GPU time was consistently over budget, and the GPU was the slower
+	  side, so the scaling was lowered.*/
+	render_governor_lower,
+	/*Frames were consistently well under budget, so the scaling was
+	  raised.*/
+	render_governor_raise,
+} render_governor_;
+
+/*Why the dynamic resolution governor made its most recent decision. See
+  render_governor_decision_t.*/
+typedef enum render_governor_reason_ {
+	/*The governor is off.*/
+	render_governor_reason_none = 0,
+	/*This GPU can't time frames, and without GPU time there's no telling
+	  whether the scaling matters, so it's left alone.*/
+	render_governor_reason_no_gpu_timing,
+	/*The scaling changed recently, and the governor is waiting for frame
+	  times to settle before judging it.*/
+	render_governor_reason_settling,
+	/*Frame time is between the raise and lower thresholds.*/
+	render_governor_reason_in_budget,
+	/*GPU time is over budget, and at least as long as CPU time. Scaling
+	  is lowered once this lasts long enough.*/
+	render_governor_reason_gpu_bound,
+	/*Frames are over budget, but the CPU is the slower side, so lowering
+	  the scaling wouldn't help.*/
+	render_governor_reason_cpu_bound,
+	/*Frame time is well under budget. Scaling is raised once this lasts
+	  long enough.*/
+	render_governor_reason_under_budget,
+	/*The governor would change the scaling, but it's already at the
+	  minimum or maximum scale it was given.*/
+	render_governor_reason_scale_limit,
+} render_governor_reason_;
+
+/*A snapshot of the dynamic resolution governor's most recent frame, handy
+  for logging or for showing on a debug overlay. Times are smoothed over
+  several frames, and are in milliseconds.*/
+typedef struct render_governor_decision_t {
+	render_governor_        action;
+	render_governor_reason_ reason;
+	float                   scale;
+	float                   cpu_ms;
+	float                   gpu_ms;
+	float                   budget_ms;
+	uint64_t                frame;
+	uint64_t                changed_frame;
+} render_governor_decision_t;
+
 /*The projection mode used by StereoKit for the main camera! You
   can use this with Renderer.Projection. These options are only
   available in flatscreen mode, as MR headsets provide very
@@ -1544,6 +1669,21 @@ typedef enum projection_ {
 	projection_ortho = 1
 } projection_;
 
+/*A single view for render_screenshot_viewpoints, these line up with the
+  parameters of render_screenshot_viewpoint. The context is passed through to
+  the callback, so each view's results can be told apart.*/
+typedef struct screenshot_view_t {
+	matrix        camera;
+	matrix        projection;
+	int32_t       width;
+	int32_t       height;
+	render_layer_ layer_filter;
+	render_clear_ clear;
+	rect_t        viewport;
+	tex_format_   tex_format;
+	void*         context;
+} screenshot_view_t;
+
 //TODO: for v0.4, rename render_set_clip and render_set_fov to indicate they are only for perspective
 SK_API void                  render_set_clip       (float near_plane sk_default(0.08f), float far_plane sk_default(50));
 SK_API void                  render_set_fov        (float field_of_view_degrees sk_default(90.0f));
@@ -1563,6 +1703,14 @@ SK_API void                  render_set_scaling    (float display_tex_scale);
 SK_API float                 render_get_scaling    (void);
 SK_API void                  render_set_multisample(int32_t display_tex_multisample);
 SK_API int32_t               render_get_multisample(void);
+SK_API render_frame_stats_t  render_stats_frame    (void);
+SK_API bool32_t              render_stats_gpu_available(void);
+SK_API float                 render_stats_gpu_ms   (render_pass_ pass);
+SK_API float                 render_stats_gpu_total_ms(void);
+SK_API uint64_t              render_stats_gpu_frame(void);
+SK_API void                  render_governor_enable(bool32_t enable, float target_hz sk_default(0), float min_scale sk_default(0.5f), float max_scale sk_default(1.0f));
+SK_API bool32_t              render_governor_enabled(void);
+SK_API render_governor_decision_t render_governor_get_decision(void);
 SK_API void                  render_override_capture_filter(bool32_t use_override_filter, render_layer_ layer_filter sk_default(render_layer_all));
 SK_API render_layer_         render_get_capture_filter     (void);
 SK_API bool32_t              render_has_capture_filter     (void);
@@ -1571,19 +1719,34 @@ SK_API color128              render_get_clear_color(void);
 SK_API void                  render_enable_skytex  (bool32_t show_sky);
 SK_API bool32_t              render_enabled_skytex (void);
 SK_API void                  render_global_texture (int32_t register_slot, tex_t texture);
+SK_API void                  render_set_sort       (int32_t queue_start, int32_t queue_end, render_sort_ sort);
 SK_API void                  render_add_mesh       (mesh_t mesh, material_t material, const sk_ref(matrix) transform, color128 color_linear sk_default({1,1,1,1}), render_layer_ layer sk_default(render_layer_0));
+SK_API void                  render_add_occluder   (mesh_t mesh, const sk_ref(matrix) transform);
+SK_API void                  render_add_mesh_instanced(mesh_t mesh, material_t material, const matrix *transforms, const color128 *colors_linear, int32_t count, render_layer_ layer sk_default(render_layer_0));
 SK_API void                  render_add_model      (model_t model, const sk_ref(matrix) transform, color128 color_linear sk_default({1,1,1,1}), render_layer_ layer sk_default(render_layer_0));
 SK_API void                  render_add_model_mat  (model_t model, material_t material_override, const sk_ref(matrix) transform, color128 color_linear sk_default({1,1,1,1}), render_layer_ layer sk_default(render_layer_0));
 SK_API void                  render_blit           (tex_t to_rendertarget, material_t material);
 //TODO: for v0.4, replace render_screenshot with render_screenshot_pose
 SK_API void                  render_screenshot     (const char *file_utf8, vec3 from_viewpt, vec3 at, int32_t width, int32_t height, float field_of_view_degrees);
 SK_API void                  render_screenshot_pose(const char *file_utf8, int32_t file_quality_100, pose_t viewpoint, int32_t width, int32_t height, float field_of_view_degrees);
+SK_API void                  render_screenshot_file(const char *file_utf8, int32_t file_quality_100, pose_t viewpoint, int32_t width, int32_t height, float field_of_view_degrees, void (*on_complete)(const char *file_utf8, bool32_t success, void *context), void *context sk_default(nullptr));
 SK_API void                  render_screenshot_capture  (void (*render_on_screenshot_callback)(color32* color_buffer, int32_t width, int32_t height, void* context), pose_t viewpoint, int32_t width, int32_t height, float field_of_view_degrees);
 SK_API void                  render_screenshot_viewpoint(void (*render_on_screenshot_callback)(color32* color_buffer, int32_t width, int32_t height, void* context), matrix camera, matrix projection, int32_t width, int32_t height, render_layer_ layer_filter sk_default(render_layer_all), render_clear_ clear sk_default(render_clear_all), rect_t viewport sk_default(rect_t{}), tex_format_ tex_format sk_default(tex_format_rgba32));
+SK_API void                  render_screenshot_viewpoints(void (*render_on_screenshot_callback)(color32* color_buffer, int32_t width, int32_t height, void* context), const screenshot_view_t *views, int32_t view_count);
+SK_API tex_t                 render_transient_target(int32_t width, int32_t height, tex_format_ color_format sk_default(tex_format_rgba32), int32_t multisample sk_default(1));
 SK_API void                  render_to             (tex_t to_rendertarget, const sk_ref(matrix) camera, const sk_ref(matrix) projection, render_layer_ layer_filter sk_default(render_layer_all), render_clear_ clear sk_default(render_clear_all), rect_t viewport sk_default({}));
 SK_API void                  render_material_to    (tex_t to_rendertarget, material_t override_material, const sk_ref(matrix) camera, const sk_ref(matrix) projection, render_layer_ layer_filter sk_default(render_layer_all), render_clear_ clear sk_default(render_clear_all), rect_t viewport sk_default({}));
 SK_API void                  render_get_device     (void **device, void **context);
 
+typedef int32_t render_list_t;
+
+SK_API render_list_t         render_list_create      (void);
+SK_API void                  render_list_release     (render_list_t list);
+SK_API void                  render_list_push        (render_list_t list);
+SK_API void                  render_list_pop         (void);
+SK_API void                  render_list_clear       (render_list_t list);
+SK_API void                  render_list_set_retained(render_list_t list, bool32_t retained);
+
 ///////////////////////////////////////////
 
 SK_API void          hierarchy_push              (const sk_ref(matrix) transform);
@@ -2307,6 +2470,32 @@ typedef enum asset_type_ {
 
 typedef void* asset_t;
 
+/*How long one finished asset loading task took, and what it estimated its
+  own cost at. Comparing the two is how the estimates get calibrated.*/
+typedef struct asset_task_timing_t {
+	asset_type_ type;
+	int32_t     priority;
+	int32_t     complexity;
+	float       wait_ms;
+	float       thread_ms;
+	float       gpu_ms;
+	float       total_ms;
+} asset_task_timing_t;
+
+/*Counters for the GPU uploads assets_step does on the main thread. A step
+  is one call to assets_step, normally once per frame. Each step stops
+  running upload jobs once assets_set_upload_budget's milliseconds are
+  spent, a budget of 0 or less removes the limit.*/
+typedef struct asset_upload_stats_t {
+	int32_t pending;        // Jobs left waiting after the last step
+	int32_t uploaded;       // Jobs run during the last step
+	float   last_ms;        // Time the last step spent on jobs
+	float   max_ms;         // Longest any step has spent on jobs
+	int32_t deferred_steps; // Steps that ran out of budget and left jobs for later
+	int32_t hitch_steps;    // Steps that went over budget, from one big job
+	int64_t total_uploaded;
+} asset_upload_stats_t;
+
 SK_API void        assets_releaseref_threadsafe(void *asset);
 SK_API int32_t     assets_current_task         (void);
 SK_API int32_t     assets_total_tasks          (void);
@@ -2315,6 +2504,15 @@ SK_API void        assets_block_for_priority   (int32_t priority);
 SK_API int32_t     assets_count                (void);
 SK_API asset_t     assets_get_index            (int32_t index);
 SK_API asset_type_ assets_get_type             (int32_t index);
+SK_API int32_t     assets_task_timing_count    (void);
+SK_API asset_task_timing_t assets_task_timing_get(int32_t index);
+SK_API void        assets_set_upload_budget    (float budget_ms);
+SK_API float       assets_get_upload_budget    (void);
+SK_API asset_upload_stats_t assets_get_upload_stats(void);
+SK_API void        assets_set_cache_folder     (const char *folder_utf8);
+SK_API const char *assets_get_cache_folder     (void);
+SK_API void        assets_set_cache_limit      (uint64_t max_bytes);
+SK_API uint64_t    assets_get_cache_limit      (void);
 
 SK_API asset_type_ asset_get_type(asset_t asset);
 SK_API void        asset_set_id  (asset_t asset, const char* id);
@@ -39,7 +39,10 @@ Paul Melis, SURF (paul.melis@surf.nl)
 #include "../sk_memory.h"
 #include "../sk_math.h"
 #include "../asset_types/mesh.h"
+#include "../asset_types/asset_cache.h"
 #include "../libraries/sokol_time.h"
+#include "../libraries/ferr_hash.h"
+#include "../libraries/stref.h"
 
 //#define VERBOSE_BUILD
 //#define VERBOSE_INTERSECTION
@@ -455,6 +458,7 @@ mesh_bvh_create(const mesh_t mesh, int acc_leaf_size, bool show_stats)
 
     mesh_bvh_build_recursive(0, nodes, &next_node_index, sorted_triangles,
         acc_leaf_size, triangle_vertices, triangle_centroids, bvh->collision_data);
+    bvh->node_count = next_node_index;
 
 #if defined(VERBOSE_STATS)
     const double t1 = time_get_raw();
@@ -485,6 +489,67 @@ mesh_bvh_create(const mesh_t mesh, int acc_leaf_size, bool show_stats)
     return bvh;
 }
 
+// Below this many triangles, building is quicker than hashing the mesh and
+// going to disk.
+const uint32_t bvh_cache_min_triangles = 4096;
+const uint32_t bvh_cache_tag_nodes     = asset_cache_tag('n','o','d','e');
+const uint32_t bvh_cache_tag_triangles = asset_cache_tag('t','r','i','s');
+
+// Same as mesh_bvh_create, but for meshes loaded from files, the BVH goes
+// through the asset cache. Entries are matched against the mesh's triangle
+// positions, so an edited mesh just builds a new one.
+mesh_bvh_t*
+mesh_bvh_create_cached(const mesh_t mesh, int acc_leaf_size)
+{
+    const char *id            = mesh->header.id_text;
+    uint32_t    num_triangles = mesh->ind_count / 3;
+    if (!asset_cache_enabled() || id == nullptr || string_startswith(id, "auto/") || num_triangles < bvh_cache_min_triangles)
+        return mesh_bvh_create(mesh, acc_leaf_size);
+
+    const mesh_collision_t *collision_data = mesh_get_collision_data(mesh);
+    if (collision_data == nullptr)
+        return mesh_bvh_create(mesh, acc_leaf_size);
+
+    uint64_t key  = hash_fnv64_data(&acc_leaf_size, sizeof(acc_leaf_size), hash_fnv64_string(id, hash_fnv64_string("sk_bvh")));
+    uint64_t hash = asset_cache_hash(collision_data->pts, sizeof(vec3) * 3 * num_triangles, HASH_FNV64_START);
+
+    asset_cache_t *entry = asset_cache_open(key, hash);
+    if (entry != nullptr)
+    {
+        uint64_t    nodes_size     = 0;
+        uint64_t    triangles_size = 0;
+        const void *nodes          = asset_cache_get(entry, bvh_cache_tag_nodes,     0, &nodes_size);
+        const void *triangles      = asset_cache_get(entry, bvh_cache_tag_triangles, 0, &triangles_size);
+        if (nodes != nullptr && triangles != nullptr && nodes_size > 0 &&
+            nodes_size     % sizeof(bvh_node_t) == 0 &&
+            triangles_size == sizeof(uint32_t) * num_triangles)
+        {
+            mesh_bvh_t *bvh = sk_calloc_t(mesh_bvh_t, 1);
+            bvh->the_mesh         = mesh;
+            bvh->collision_data   = collision_data;
+            bvh->node_count       = (uint32_t)(nodes_size / sizeof(bvh_node_t));
+            bvh->nodes            = sk_malloc_t(bvh_node_t, bvh->node_count);
+            bvh->sorted_triangles = sk_malloc_t(uint32_t,   num_triangles);
+            memcpy(bvh->nodes,            nodes,     (size_t)nodes_size);
+            memcpy(bvh->sorted_triangles, triangles, (size_t)triangles_size);
+            asset_cache_close(entry);
+            return bvh;
+        }
+        asset_cache_close(entry);
+    }
+
+    mesh_bvh_t *bvh = mesh_bvh_create(mesh, acc_leaf_size);
+    if (bvh != nullptr)
+    {
+        asset_cache_section_t sections[2] = {
+            { bvh_cache_tag_nodes,     bvh->nodes,            sizeof(bvh_node_t) * bvh->node_count },
+            { bvh_cache_tag_triangles, bvh->sorted_triangles, sizeof(uint32_t)   * num_triangles   },
+        };
+        asset_cache_write(key, hash, sections, 2);
+    }
+    return bvh;
+}
+
 void
 mesh_bvh_destroy(mesh_bvh_t *bvh)
 {
@@ -21,10 +21,12 @@ struct mesh_bvh_t
     const mesh_collision_t *collision_data;
 
     bvh_node_t          *nodes;
+    uint32_t            node_count;
     uint32_t            *sorted_triangles;    
 };
 
 mesh_bvh_t* mesh_bvh_create(const mesh_t mesh, int acc_leaf_size=16, bool show_stats=true);
+mesh_bvh_t* mesh_bvh_create_cached(const mesh_t mesh, int acc_leaf_size=16);
 void        mesh_bvh_destroy(mesh_bvh_t* bvh);
 bool        mesh_bvh_intersect(const mesh_bvh_t *bvh, ray_t model_space_ray, ray_t *out_pt, uint32_t* out_start_inds, cull_ cull_mode);
 void        mesh_bvh_statistics(const mesh_bvh_t *bvh, bvh_stats_t *stats, int acc_leaf_size=16);
@@ -1,10 +1,17 @@
 #include "render.h"
+#include "render_sort.h"
+#include "render_occlusion.h"
 #include "world.h"
+#include "system.h"
 #include "defaults.h"
 #include "../_stereokit.h"
 #include "../device.h"
 #include "../libraries/sk_gpu.h"
 #include "../libraries/stref.h"
+#include "../libraries/ferr_thread.h"
+#include "../libraries/atomic_util.h"
+#include "../libraries/sokol_time.h"
+#include "../sk_math.h"
 #include "../sk_math_dx.h"
 #include "../sk_memory.h"
 #include "../spherical_harmonics.h"
@@ -30,6 +37,7 @@
 #define STB_IMAGE_WRITE_STATIC
 #define STBIW_WINDOWS_UTF8
 #include "../libraries/stb_image_write.h"
+#include "../libraries/qoi.h"
 #pragma warning(pop)
 
 using namespace DirectX;
@@ -38,27 +46,77 @@ namespace sk {
 
 ///////////////////////////////////////////
 
+// Render items don't carry their own transform or color, those live in the
+// list's instance arena, already in the layout the GPU wants. Items are
+// never moved around when sorting either, only render_sort_key_t is.
 struct render_item_t {
-	XMMATRIX    transform;
-	color128    color;
+	XMVECTOR    bounds_center;
+	XMVECTOR    bounds_extents;
 	uint64_t    sort_id;
 	mesh_t      mesh;
 	material_t  material;
 	int32_t     mesh_inds;
+	int32_t     inst_start;
+	int32_t     inst_count;
 	uint16_t    layer;
+	uint8_t     sort;
+};
+struct render_sort_key_t {
+	uint64_t    sort_id;
+	uint32_t    index;
 };
 
-struct _render_list_t {
-	array_t<render_item_t> queue;
-	render_stats_t         stats;
-	render_list_state_     state;
-	bool                   prepped;
+struct render_queue_offset_t {
+	uint64_t    sort_id;    // Queue bits only, the rest are zero
+	int32_t     start;      // First index in sorted with this queue
 };
 
 struct render_transform_buffer_t {
 	XMMATRIX world;
 	color128 color;
 };
+
+struct _render_list_t {
+	array_t<render_item_t>             queue;
+	array_t<render_sort_key_t>         sorted;
+	array_t<render_sort_key_t>         sorted_mesh;
+	array_t<render_queue_offset_t>     queue_offsets;
+	array_t<render_transform_buffer_t> instances;
+	render_stats_t                     stats;
+	render_list_state_                 state;
+	bool                               prepped;
+	bool                               retained;
+	bool                               back_to_front;
+	bool                               borrowed;
+	bool                               prepped_mesh;
+};
+struct render_sort_range_t {
+	int32_t      queue_start;
+	int32_t      queue_end;
+	render_sort_ sort;
+};
+struct render_thread_list_t {
+	ft_mutex_t     mtx;    // Held while recording into list, and while merging it
+	ft_id_t        thread;
+	_render_list_t list;
+	uint64_t       frame;  // Last frame this thread recorded anything for
+	int32_t        in_use;
+};
+struct render_sort_pool_t {
+	ft_mutex_t       mtx;
+	ft_condition_t   work_ready;
+	ft_condition_t   work_done;
+	int32_t          thread_count;
+	int32_t          thread_running;
+	bool             initialized;
+	bool             quit;
+	radix_mt_work_t *work;
+	radix_job_fn     job;
+	void            *job_ctx;
+	int32_t          job_count;
+	int32_t          job_next;
+	int32_t          job_finished;
+};
 struct render_global_buffer_t {
 	XMMATRIX view[2];
 	XMMATRIX proj[2];
@@ -79,9 +137,17 @@ struct render_blit_data_t {
 	float pixel_height;
 };
 struct render_inst_buffer {
-	int32_t      max;
+	uint32_t     max;
+	uint64_t     frame;
 	skg_buffer_t buffer;
 };
+struct render_inst_run_t {
+	material_t material;
+	mesh_t     mesh;
+	int32_t    mesh_inds;
+	int32_t    inst_start;
+	int32_t    inst_count;
+};
 struct render_screenshot_t {
 	void        (*render_on_screenshot_callback)(color32* color_buffer, int32_t width, int32_t height, void* context);
 	void*         context;
@@ -94,6 +160,77 @@ struct render_screenshot_t {
 	render_clear_ clear;
 	tex_format_	  tex_format;
 };
+struct render_target_entry_t {
+	tex_t         target;
+	int32_t       width;
+	int32_t       height;
+	tex_format_   format;
+	int32_t       multisample;
+	uint64_t      frame;
+	bool          in_use;
+};
+struct render_capture_target_t {
+	tex_t         resolve;
+	int32_t       width;
+	int32_t       height;
+	tex_format_   format;
+	uint64_t      frame;
+};
+struct render_capture_readback_t {
+	skg_readback_t readback;
+	uint64_t       frame;
+};
+struct render_capture_t {
+	void        (*render_on_screenshot_callback)(color32* color_buffer, int32_t width, int32_t height, void* context);
+	void*         context;
+	skg_readback_t readback;
+	uint64_t      frame;
+};
+struct render_file_job_t {
+	char         *filename;
+	int32_t       quality;
+	color32      *color_buffer;
+	int32_t       width;
+	int32_t       height;
+	bool32_t      success;
+	void        (*on_complete)(const char *file_utf8, bool32_t success, void *context);
+	void         *context;
+};
+struct render_file_writer_t {
+	ft_mutex_t    mtx;
+	ft_condition_t work_ready;
+	bool          initialized;
+	bool          running;
+	bool          quit;
+	array_t<render_file_job_t> jobs;
+	array_t<render_file_job_t> finished;
+};
+struct render_occluder_t {
+	mesh_t        mesh;
+	XMMATRIX      world;
+};
+struct render_gpu_timer_t {
+	skg_timer_t   timer;
+	render_pass_  pass;
+};
+struct render_gpu_frame_t {
+	array_t<render_gpu_timer_t> timers;
+	uint64_t      frame;
+};
+struct render_governor_t {
+	bool32_t      enabled;
+	float         target_hz;
+	float         min_scale;
+	float         max_scale;
+	bool          has_sample;
+	uint64_t      cpu_total;
+	float         cpu_ms;
+	float         gpu_ms;
+	int32_t       over_frames;
+	int32_t       under_frames;
+	int32_t       cooldown;
+	render_governor_decision_t decision;
+};
 struct render_viewpoint_t {
 	tex_t         rendertarget;
 	matrix        camera;
@@ -110,7 +247,11 @@ struct render_state_t {
 	bool32_t                initialized;
 
 	array_t<render_transform_buffer_t> instance_list;
-	skg_buffer_t                       instance_buffer;
+	array_t<render_inst_run_t>         instance_runs;
+	array_t<render_inst_buffer>        instance_ring;
+	int32_t                            instance_ring_curr;
+	render_inst_buffer                 instance_overflow;
+	bool                               instance_bind_range;
 
 	material_buffer_t       shader_globals;
 	skg_buffer_t            shader_blit;
@@ -129,6 +270,12 @@ struct render_state_t {
 	float                   ortho_viewport_height;
 
 	render_global_buffer_t  global_buffer;
+	uint64_t                global_frame;
+	bool                    global_refresh;
+	bool                    global_dirty;
+	bool                    global_binds_valid;
+	bool                    global_bound_buffers[_countof(material_buffers)];
+	const skg_tex_t        *global_bound_textures[16];
 	mesh_t                  blit_quad;
 	vec4                    lighting[9];
 	spherical_harmonics_t   lighting_src;
@@ -136,12 +283,32 @@ struct render_state_t {
 	render_list_t           list_primary;
 	float                   scale;
 	int32_t                 multisample;
+	render_governor_t       governor;
+	bool32_t                gpu_timing;
+	render_gpu_frame_t      gpu_frames[4];
+	int32_t                 gpu_frame_curr;
+	array_t<skg_timer_t>    gpu_timer_pool;
+	render_frame_stats_t    frame_stats;
+	float                   gpu_pass_ms[render_pass_max];
+	float                   gpu_total_ms;
+	uint64_t                gpu_ms_frame;
 	render_layer_           primary_filter;
 	render_layer_           capture_filter;
 	bool                    use_capture_filter;
 	tex_t                   global_textures[16];
 
 	array_t<render_screenshot_t> screenshot_list;
+	array_t<render_target_entry_t>     target_pool;
+	int32_t                 target_pool_hits;
+	int32_t                 target_pool_misses;
+	int32_t                 target_pool_frame_hits;
+	int32_t                 target_pool_frame_misses;
+	array_t<render_capture_target_t>   capture_targets;
+	array_t<render_capture_readback_t> capture_readbacks;
+	array_t<render_capture_t>          capture_pending;
+	color32                *capture_buffer;
+	size_t                  capture_buffer_size;
+	render_file_writer_t    file_writer;
 	array_t<render_viewpoint_t>  viewpoint_list;
 
 	mesh_t                  sky_mesh;
@@ -152,15 +319,56 @@ struct render_state_t {
 	shader_t                last_shader;
 	mesh_t                  last_mesh;
 
+	XMVECTOR                cull_planes[2][5];
+	int32_t                 cull_view_count;
+	array_t<render_occluder_t> occluders;
+	ft_mutex_t              occluder_mtx;
+	occlusion_buffer_t      occlusion[2];
+	float                  *occlusion_depth;
+	int32_t                 occlusion_view_count;
+	XMMATRIX                sort_view;
+	render_sort_key_t      *sort_scratch;
+	size_t                  sort_scratch_size;
+	render_sort_pool_t      sort_pool;
+	array_t<render_sort_range_t> sort_ranges;
+
 	array_t< render_list_t> list_stack;
 	array_t<_render_list_t> lists;
 	render_list_t           list_active;
+	array_t< render_list_t> list_retained;
+	bool                    list_retained_prepped;
+
+	render_thread_list_t    thread_lists[64];
+	int32_t                 thread_list_count;
+	ft_mutex_t              thread_list_mtx;
 
 };
 static render_state_t local = {};
 
 const int32_t    render_instance_max     = 819;
+const int32_t    render_instance_align   = 16;   // 16*80 bytes is a multiple of the 256 byte bind alignment
+const int32_t    render_instance_chunk   = 816;  // Largest multiple of render_instance_align that fits render_instance_max
+const uint32_t   render_instance_window  = 65536;
+const uint64_t   render_instance_frames  = 3;    // Frames the GPU may still be reading a ring buffer for
+const int32_t    render_instance_ring_max= 64;
+const int32_t    render_retained_max     = 16;
+const uint64_t   render_thread_list_keep = 60;   // Frames an idle thread keeps its recording slot for
+const uint64_t   render_capture_latency  = 3;    // Frames a screenshot can wait on the GPU before we block for it
+const uint64_t   render_capture_keep     = 60;   // Frames an unused capture target or readback sticks around for
+const uint64_t   render_target_keep      = 8;    // Frames an unused pooled render target sticks around for
+const size_t     render_sort_mt_min      = 32768; // Below this, waking sort threads costs more than it saves
+const size_t     render_sort_mt_chunk    = 8192;  // Smallest share of the queue worth handing to a sort job
+const int32_t    render_occlusion_width  = 256;  // Must be a multiple of 4
+const int32_t    render_occlusion_height = 128;
 const int32_t    render_skytex_register  = 11;
+const float      render_governor_smooth  = 0.1f;  // Weight each new frame gets in the smoothed frame times
+const float      render_governor_high    = 0.95f; // Fraction of the frame budget that counts as over budget
+const float      render_governor_low     = 0.75f; // Fraction of the frame budget that leaves room to raise scaling
+const float      render_governor_goal    = 0.85f; // Fraction of the frame budget a lowered scale aims for
+const float      render_governor_step    = 0.05f; // Scaling changes come in multiples of this
+const int32_t    render_governor_lower_frames = 15;  // Frames over budget before lowering
+const int32_t    render_governor_raise_frames = 120; // Frames under budget before raising
+const int32_t    render_governor_cooldown     = 60;  // Frames to let a change settle before judging it
 const skg_bind_t render_list_global_bind = { 1,  skg_stage_vertex | skg_stage_pixel, skg_register_constant };
 const skg_bind_t render_list_inst_bind   = { 2,  skg_stage_vertex | skg_stage_pixel, skg_register_constant };
 const skg_bind_t render_list_blit_bind   = { 2,  skg_stage_vertex | skg_stage_pixel, skg_register_constant };
@@ -168,18 +376,56 @@ const skg_bind_t render_list_blit_bind   = { 2,  skg_stage_vertex | skg_stage_pi
 ///////////////////////////////////////////
 
 void          render_set_material     (material_t material);
-skg_buffer_t *render_fill_inst_buffer (array_t<render_transform_buffer_t> &list, int32_t &offset, int32_t &out_count);
+skg_buffer_t *render_inst_ring_next   (_render_list_t *list, uint32_t size_bytes);
 void          render_save_to_file     (color32* color_buffer, int width, int height, void* context);
+bool32_t      render_file_encode      (const render_file_job_t *job);
+void          render_file_writer_init ();
+void          render_file_writer_shutdown();
+void          render_file_writer_poll ();
 void          render_check_screenshots();
+void          render_capture_poll     (bool flush);
+void          render_capture_trim     ();
+render_capture_target_t *render_capture_target(int32_t width, int32_t height, tex_format_ format);
+skg_readback_t render_capture_readback(const skg_tex_t *tex);
 void          render_check_viewpoints ();
-
+void          render_governor_update  ();
+int32_t       render_gpu_begin        (render_pass_ pass);
+void          render_gpu_end          (int32_t timer);
+void          render_gpu_frame        ();
+bool          render_gpu_resolve      (render_gpu_frame_t *frame);
+void          render_globals_set_camera(const matrix *views, const matrix *projections, int32_t view_count, XMMATRIX *out_viewprojs);
+void          render_globals_set_frame();
+void          render_globals_bind     ();
+void          render_globals_target   (tex_t render_target);
+void          render_draw_queue       (const matrix *views, const matrix *projections, render_layer_ filter, int32_t view_count, material_t override_material, bool primary);
+tex_t         render_target_pool_get  (int32_t width, int32_t height, tex_format_ format, int32_t multisample);
+void          render_target_pool_return(tex_t target);
+void          render_target_pool_frame();
+
+bool          render_list_valid       (render_list_t list, const char *function);
+void          render_list_destroy     (render_list_t list);
 void          render_list_prep        (render_list_t list);
+void          render_list_prep_retained();
+void          render_list_prep_mesh   (_render_list_t *list);
 void          render_list_add         (const render_item_t *item);
-void          render_list_add_to      (render_list_t list, const render_item_t *item);
-
-void          radix_sort7             (render_item_t *a, size_t count);
-void          radix_sort_clean        ();
-void          radix_sort_init         ();
+_render_list_t *render_list_recording (bool *out_main_thread, render_thread_list_t **out_slot);
+void          render_list_recording_end(render_thread_list_t *slot);
+void          render_list_merge_threads(render_list_t list);
+void          render_list_execute_merged(render_list_t list, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end, material_t override_material);
+void          render_item_set_bounds  (render_item_t *item, mesh_t mesh, const XMMATRIX &world);
+int32_t       render_model_lod        (const model_visual_t *vis, const render_item_t *item, XMVECTOR eye, float coverage_scale);
+int32_t       render_list_add_instance(_render_list_t *list, const XMMATRIX &world, color128 color);
+void          render_cull_set_views   (const XMMATRIX *viewprojs, int32_t view_count);
+bool          render_cull_visible     (const render_item_t *item);
+void          render_occlusion_prepare(const XMMATRIX *viewprojs, int32_t view_count);
+bool          render_occlusion_visible(const render_item_t *item);
+void          render_list_add_to      (_render_list_t *list, const render_item_t *item);
+
+void          render_sort_keys        (render_sort_key_t *keys, size_t count);
+int32_t       render_list_queue_offset(const _render_list_t *list, uint64_t sort_id);
+void          render_sort_pool_init   ();
+void          render_sort_pool_shutdown();
+void          render_sort_pool_dispatch(radix_job_fn job, void *job_ctx, int32_t job_count);
 
 ///////////////////////////////////////////
 
@@ -198,6 +444,15 @@ bool render_init() {
 	local.ortho_viewport_height = 1.0f;
 	local.clear_col             = color128{0,0,0,0};
 	local.list_primary          = -1;
+	local.thread_list_mtx       = ft_mutex_create();
+	for (int32_t i = 0; i < (int32_t)_countof(local.thread_lists); i++)
+		local.thread_lists[i].mtx = ft_mutex_create();
+	local.occluder_mtx          = ft_mutex_create();
+	local.sort_view             = XMMatrixIdentity();
+	local.global_refresh        = true;
+	render_set_sort(0,    2000,    render_sort_state_first);
+	render_set_sort(2000, 3000,    render_sort_back_to_front);
+	render_set_sort(3000, INT_MAX, render_sort_state_first);
 	local.scale                 = 1;
 	local.multisample           = 1;
 	local.primary_filter        = render_layer_all_first_person;
@@ -210,11 +465,10 @@ bool render_init() {
 	skg_buffer_name(&local.shader_blit, "sk/render/blit_buffer");
 #endif
 	
-	local.instance_buffer = skg_buffer_create(nullptr, render_instance_max, sizeof(render_transform_buffer_t), skg_buffer_type_constant, skg_use_dynamic);
-#if !defined(SKG_OPENGL) && (defined(_DEBUG) || defined(SK_GPU_LABELS))
-	skg_buffer_name(&local.instance_buffer, "sk/render/instance_buffer");
-#endif
+	local.instance_bind_range = skg_capability(skg_cap_buffer_bind_range);
+	local.instance_ring_curr  = -1;
 	local.instance_list.resize(render_instance_max);
+	local.gpu_timing          = skg_capability(skg_cap_gpu_timer);
 
 	// Setup a default camera
 	render_set_clip(local.clip_planes.x, local.clip_planes.y);
@@ -230,8 +484,11 @@ bool render_init() {
 		vert_t{ { 1, 1,1}, {0,0,1}, {1,0}, {255,255,255,255} },
 		vert_t{ { 1,-1,1}, {0,0,1}, {1,1}, {255,255,255,255} },
 		vert_t{ {-1,-1,1}, {0,0,1}, {0,1}, {255,255,255,255} }, };
-	mesh_set_data(local.sky_mesh, verts, _countof(verts), inds, _countof(inds));
-	mesh_set_id  (local.sky_mesh, "sk/render/skybox_mesh");
+	// The skybox is drawn in clip space, so it gets empty bounds to keep it
+	// from ever being frustum culled.
+	mesh_set_data  (local.sky_mesh, verts, _countof(verts), inds, _countof(inds), false);
+	mesh_set_bounds(local.sky_mesh, bounds_t{});
+	mesh_set_id    (local.sky_mesh, "sk/render/skybox_mesh");
 
 	shader_t shader_sky = shader_find(default_id_shader_sky);
 	local.sky_mat = material_create(shader_sky);
@@ -246,10 +503,12 @@ bool render_init() {
 	render_enable_skytex(true);
 	tex_release(sky_cubemap);
 	
+	// The primary list is emptied every frame, so it can borrow its assets
+	// for the frame rather than referencing each one.
 	local.list_primary = render_list_create();
+	local.lists[local.list_primary].borrowed = true;
 	render_list_push(local.list_primary);
 
-	radix_sort_init();
 	hierarchy_init();
 
 	render_update_projection();
@@ -261,15 +520,47 @@ bool render_init() {
 
 void render_shutdown() {
 	for (int32_t i = 0; i < local.lists.count; i++) {
-		render_list_release(i);
+		render_list_destroy(i);
 	}
 	local.lists          .free();
 	local.list_stack     .free();
+	local.list_retained  .free();
+	local.sort_ranges    .free();
 	local.screenshot_list.free();
 	local.viewpoint_list .free();
+
+	// Anything still waiting on the GPU gets delivered before we go, and
+	// files still being encoded get finished off.
+	render_capture_poll(true);
+	render_file_writer_shutdown();
+	for (int32_t i = 0; i < local.capture_targets.count; i++) {
+		tex_release(local.capture_targets[i].resolve);
+	}
+	for (int32_t i = 0; i < local.capture_readbacks.count; i++) {
+		skg_readback_destroy(&local.capture_readbacks[i].readback);
+	}
+	local.capture_targets  .free();
+	local.capture_readbacks.free();
+	local.capture_pending  .free();
+	if (local.target_pool_hits + local.target_pool_misses > 0)
+		log_diagf("Render target pool: %d hits, %d misses", local.target_pool_hits, local.target_pool_misses);
+	for (int32_t i = 0; i < local.target_pool.count; i++) {
+		tex_release(local.target_pool[i].target);
+	}
+	local.target_pool      .free();
+	sk_free(local.capture_buffer);
+
+	for (int32_t f = 0; f < (int32_t)_countof(local.gpu_frames); f++) {
+		for (int32_t i = 0; i < local.gpu_frames[f].timers.count; i++)
+			skg_timer_destroy(&local.gpu_frames[f].timers[i].timer);
+		local.gpu_frames[f].timers.free();
+	}
+	for (int32_t i = 0; i < local.gpu_timer_pool.count; i++)
+		skg_timer_destroy(&local.gpu_timer_pool[i]);
+	local.gpu_timer_pool.free();
 	local.instance_list  .free();
 
-	for (int32_t i = 0; i < _countof(local.global_textures); i++) {
+	for (int32_t i = 0; i < (int32_t)_countof(local.global_textures); i++) {
 		tex_release(local.global_textures[i]);
 		local.global_textures[i] = nullptr;
 	}
@@ -278,12 +569,29 @@ void render_shutdown() {
 	mesh_release           (local.blit_quad);
 	material_buffer_release(local.shader_globals);
 
-	skg_buffer_destroy(&local.instance_buffer);
+	for (int32_t i = 0; i < local.instance_ring.count; i++) {
+		skg_buffer_destroy(&local.instance_ring[i].buffer);
+	}
+	local.instance_ring.free();
+	skg_buffer_destroy(&local.instance_overflow.buffer);
+	local.instance_runs.free();
+	for (int32_t i = 0; i < local.thread_list_count; i++) {
+		local.thread_lists[i].list.queue    .free();
+		local.thread_lists[i].list.instances.free();
+	}
+	for (int32_t i = 0; i < (int32_t)_countof(local.thread_lists); i++)
+		ft_mutex_destroy(&local.thread_lists[i].mtx);
+	ft_mutex_destroy(&local.thread_list_mtx);
+	ft_mutex_destroy(&local.occluder_mtx);
+	local.occluders.free();
+	sk_free(local.occlusion_depth);
 	skg_buffer_destroy(&local.shader_blit);
 
+	render_sort_pool_shutdown();
+	sk_free(local.sort_scratch);
+
 	local = {};
 
-	radix_sort_clean();
 	hierarchy_shutdown();
 }
 
@@ -291,6 +599,7 @@ void render_shutdown() {
 
 void render_step() {
 	hierarchy_step();
+	render_governor_update();
 
 	if (local.sky_show && device_display_get_blend() == display_blend_opaque) {
 		render_add_mesh(local.sky_mesh, local.sky_mat, matrix_identity, {1,1,1,1}, render_layer_vfx);
@@ -299,11 +608,46 @@ void render_step() {
 
 ///////////////////////////////////////////
 
-inline uint64_t render_sort_id(material_t material, mesh_t mesh) {
-	return ((uint64_t)(material->alpha_mode*1000 + material->queue_offset) << 32) | (material->header.index << 16) | mesh->header.index;
+// Sort ids are laid out as 16 bits of queue position, followed by 16 bits
+// each of material, mesh, and quantized depth. State-first sorting puts the
+// depth last, and the other modes put it right after the queue position.
+// Depth is filled in by render_list_prep, once the camera is known.
+inline render_sort_ render_sort_for_queue(int32_t queue_position) {
+	// Later ranges take priority over earlier ones
+	for (int32_t i = local.sort_ranges.count - 1; i >= 0; i--) {
+		if (queue_position >= local.sort_ranges[i].queue_start && queue_position < local.sort_ranges[i].queue_end)
+			return local.sort_ranges[i].sort;
+	}
+	return render_sort_state_first;
+}
+inline uint64_t render_sort_id(material_t material, mesh_t mesh, uint8_t *out_sort) {
+	int32_t      queue = material->alpha_mode*1000 + material->queue_offset;
+	render_sort_ sort  = render_sort_for_queue(queue);
+	uint64_t     state = ((uint64_t)(material->header.index & 0xFFFF) << 16) | (uint64_t)(mesh->header.index & 0xFFFF);
+	queue = queue < 0 ? 0 : (queue > 0xFFFF ? 0xFFFF : queue);
+
+	*out_sort = (uint8_t)sort;
+	return ((uint64_t)queue << 48) | (sort == render_sort_state_first ? state << 16 : state);
 }
 inline uint64_t render_sort_id_from_queue(int32_t queue_position) {
-	return (uint64_t)(queue_position) << 32;
+	if (queue_position <= 0     ) return 0;
+	if (queue_position >  0xFFFF) return UINT64_MAX;
+	return (uint64_t)queue_position << 48;
+}
+inline uint64_t render_sort_id_depth(uint64_t sort_id, uint8_t sort, float depth) {
+	// The top bits of a positive float sort the same as the float itself,
+	// and give us more precision up close than far away.
+	uint32_t bits;
+	depth = depth > 0 ? depth : 0;
+	memcpy(&bits, &depth, sizeof(bits));
+	uint64_t key = bits >> 16;
+
+	switch ((render_sort_)sort) {
+	case render_sort_state_first:   return (sort_id & ~0xFFFFULL)         |  key;
+	case render_sort_depth_first:   return (sort_id & ~(0xFFFFULL << 32)) | ( key           << 32);
+	case render_sort_back_to_front: return (sort_id & ~(0xFFFFULL << 32)) | ((0xFFFF - key) << 32);
+	default: return sort_id;
+	}
 }
 
 ///////////////////////////////////////////
@@ -531,7 +875,8 @@ tex_t render_get_skytex() {
 ///////////////////////////////////////////
 
 void render_set_skylight(const spherical_harmonics_t &light_info) {
-	local.lighting_src = light_info;
+	local.lighting_src   = light_info;
+	local.global_refresh = true;
 	sh_to_fast(light_info, local.lighting);
 }
 
@@ -582,6 +927,128 @@ int32_t render_get_multisample() {
 
 ///////////////////////////////////////////
 
+void render_governor_enable(bool32_t enable, float target_hz, float min_scale, float max_scale) {
+	render_governor_t *gov = &local.governor;
+	*gov = {};
+	gov->enabled   = enable;
+	gov->target_hz = fmaxf(0, target_hz);
+	gov->min_scale = fminf(2, fmaxf(0.2f, min_scale));
+	gov->max_scale = fminf(2, fmaxf(gov->min_scale, max_scale));
+	gov->decision.action = enable ? render_governor_hold : render_governor_disabled;
+	gov->decision.reason = enable ? render_governor_reason_settling : render_governor_reason_none;
+	gov->decision.scale  = local.scale;
+
+	if (enable) {
+		render_set_scaling(fminf(gov->max_scale, fmaxf(gov->min_scale, local.scale)));
+		gov->decision.scale         = local.scale;
+		gov->decision.changed_frame = time_frame();
+	}
+}
+
+///////////////////////////////////////////
+
+bool32_t render_governor_enabled() {
+	return local.governor.enabled;
+}
+
+///////////////////////////////////////////
+
+render_governor_decision_t render_governor_get_decision() {
+	return local.governor.decision;
+}
+
+///////////////////////////////////////////
+
+// Changing the scale means resizing the swapchain, which isn't free and
+// tends to hitch a frame or two, so this is slow to react on purpose. It
+// lowers quickly when frames are consistently over budget, raises slowly
+// when they're consistently well under it, leaves a dead band between the
+// two, and waits for each change to settle before judging it. Resolution
+// only changes GPU time, so it's only lowered when the GPU is over budget
+// and is the slower side, and without GPU timing it's left alone.
+void render_governor_update() {
+	render_governor_t *gov = &local.governor;
+	if (!gov->enabled) return;
+
+	// CPU time comes from the system profile counters, which leave out time
+	// spent waiting on present. GPU time is a frame or two old, and stays
+	// at zero where timer queries aren't supported.
+	uint64_t cpu_total = systems_step_duration();
+	float    cpu_ms    = (float)stm_ms(cpu_total - gov->cpu_total);
+	float    gpu_ms    = local.gpu_total_ms;
+	gov->cpu_total = cpu_total;
+	if (!gov->has_sample) {
+		gov->has_sample = true;
+		gov->cpu_ms     = cpu_ms;
+		gov->gpu_ms     = gpu_ms;
+		return;
+	}
+	gov->cpu_ms += (cpu_ms - gov->cpu_ms) * render_governor_smooth;
+	gov->gpu_ms += (gpu_ms - gov->gpu_ms) * render_governor_smooth;
+
+	float hz = gov->target_hz > 0 ? gov->target_hz : device_display_get_refresh_rate();
+	if (hz <= 0) hz = 60;
+	float budget_ms = 1000.0f / hz;
+	float frame_ms  = fmaxf(gov->cpu_ms, gov->gpu_ms);
+
+	render_governor_        action = render_governor_hold;
+	render_governor_reason_ reason = render_governor_reason_in_budget;
+	float                   scale  = local.scale;
+	if (!local.gpu_timing) {
+		gov->over_frames  = 0;
+		gov->under_frames = 0;
+		reason = render_governor_reason_no_gpu_timing;
+	} else if (gov->cooldown > 0) {
+		gov->cooldown -= 1;
+		reason = render_governor_reason_settling;
+	} else {
+		bool over      = gov->gpu_ms > budget_ms * render_governor_high;
+		bool under     = frame_ms    < budget_ms * render_governor_low;
+		bool gpu_bound = gov->gpu_ms >= gov->cpu_ms;
+		gov->over_frames  = over && gpu_bound ? gov->over_frames  + 1 : 0;
+		gov->under_frames = under             ? gov->under_frames + 1 : 0;
+
+		if (over && !gpu_bound) {
+			reason = render_governor_reason_cpu_bound;
+		} else if (over) {
+			reason = scale > gov->min_scale ? render_governor_reason_gpu_bound : render_governor_reason_scale_limit;
+			if (gov->over_frames >= render_governor_lower_frames && scale > gov->min_scale) {
+				// Pixel count goes with the square of the scale, so aim for
+				// the goal in one jump rather than creeping down a step at a
+				// time.
+				float target = scale * sqrtf((budget_ms * render_governor_goal) / gov->gpu_ms);
+				target = fminf(floorf(target / render_governor_step) * render_governor_step, scale - render_governor_step);
+				scale  = fmaxf(gov->min_scale, target);
+				action = render_governor_lower;
+			}
+		} else if (under) {
+			reason = scale < gov->max_scale ? render_governor_reason_under_budget : render_governor_reason_scale_limit;
+			if (gov->under_frames >= render_governor_raise_frames && scale < gov->max_scale) {
+				scale  = fminf(gov->max_scale, scale + render_governor_step);
+				action = render_governor_raise;
+			}
+		}
+	}
+
+	if (action != render_governor_hold) {
+		render_set_scaling(scale);
+		gov->over_frames  = 0;
+		gov->under_frames = 0;
+		gov->cooldown     = render_governor_cooldown;
+		gov->decision.changed_frame = time_frame();
+	}
+
+	gov->decision.action    = action;
+	gov->decision.reason    = reason;
+	gov->decision.scale     = local.scale;
+	gov->decision.cpu_ms    = gov->cpu_ms;
+	gov->decision.gpu_ms    = gov->gpu_ms;
+	gov->decision.budget_ms = budget_ms;
+	gov->decision.frame     = time_frame();
+}
+
+///////////////////////////////////////////
+
 void render_override_capture_filter(bool32_t use_override_filter, render_layer_ layer_filter) {
 	local.use_capture_filter = use_override_filter;
 	local.capture_filter    = layer_filter;
@@ -616,7 +1083,7 @@ bool32_t render_enabled_skytex() {
 ///////////////////////////////////////////
 
 void render_global_texture(int32_t register_slot, tex_t texture) {
-	if (register_slot < 0 || register_slot >= _countof(local.global_textures)) {
+	if (register_slot < 0 || register_slot >= (int32_t)_countof(local.global_textures)) {
 		log_errf("render_global_texture: Register_slot should be 0-16. Received %d.", register_slot);
 		return;
 	}
@@ -627,6 +1094,7 @@ void render_global_texture(int32_t register_slot, tex_t texture) {
 		tex_release(local.global_textures[register_slot]);
 
 	local.global_textures[register_slot] = texture;
+	local.global_refresh                 = true;
 
 	if (local.global_textures[register_slot] != nullptr)
 		tex_addref(local.global_textures[register_slot]);
@@ -634,6 +1102,20 @@ void render_global_texture(int32_t register_slot, tex_t texture) {
 
 ///////////////////////////////////////////
 
+void render_set_sort(int32_t queue_start, int32_t queue_end, render_sort_ sort) {
+	// Replace an identical range rather than stacking up duplicates, the
+	// most recent setting goes last so it takes priority.
+	for (int32_t i = 0; i < local.sort_ranges.count; i++) {
+		if (local.sort_ranges[i].queue_start == queue_start && local.sort_ranges[i].queue_end == queue_end) {
+			local.sort_ranges.remove(i);
+			break;
+		}
+	}
+	local.sort_ranges.add({ queue_start, queue_end, sort });
+}
+
+///////////////////////////////////////////
+
 void render_set_clear_color(color128 color) {
 	local.clear_col = color_to_linear(color);
 }
@@ -653,29 +1135,143 @@ color128 render_get_clear_color_ln() {
 ///////////////////////////////////////////
 
 void render_add_mesh(mesh_t mesh, material_t material, const matrix &transform, color128 color, render_layer_ layer) {
+	bool                  main_thread;
+	render_thread_list_t *slot;
+	_render_list_t       *list = render_list_recording(&main_thread, &slot);
+	if (list == nullptr) return;
+
+	XMMATRIX world;
+	if (main_thread && hierarchy_use_top()) {
+		matrix_mul(transform, hierarchy_top(), world);
+	} else {
+		math_matrix_to_fast(transform, &world);
+	}
+
+	// Every material in the chain shares the same instance data
 	render_item_t item;
-	item.mesh      = mesh;
-	item.mesh_inds = mesh->ind_draw;
-	item.color     = color;
-	item.layer     = (uint16_t)layer;
-	if (hierarchy_use_top()) {
-		matrix_mul(transform, hierarchy_top(), item.transform);
+	item.mesh       = mesh;
+	item.mesh_inds  = mesh->ind_draw;
+	item.layer      = (uint16_t)layer;
+	item.inst_start = render_list_add_instance(list, world, color);
+	item.inst_count = 1;
+	render_item_set_bounds(&item, mesh, world);
+
+	material_t curr = material;
+	while (curr != nullptr) {
+		item.material = curr;
+		item.sort_id  = render_sort_id(curr, mesh, &item.sort);
+		render_list_add_to(list, &item);
+		curr = curr->chain;
+	}
+	render_list_recording_end(slot);
+}
+
+///////////////////////////////////////////
+
+void render_add_occluder(mesh_t mesh, const matrix &transform) {
+	// Occluders are rasterized on the CPU, so they need the mesh's data.
+	if (mesh->verts == nullptr || mesh->inds == nullptr) {
+		static bool warned = false;
+		if (!warned) log_warn("render_add_occluder needs a mesh that keeps its data on the CPU, occluders without it will be skipped!");
+		warned = true;
+		return;
+	}
+
+	render_occluder_t occluder;
+	occluder.mesh = mesh;
+	if (sk_is_main_thread() && hierarchy_use_top()) {
+		matrix_mul(transform, hierarchy_top(), occluder.world);
 	} else {
-		math_matrix_to_fast(transform, &item.transform);
+		math_matrix_to_fast(transform, &occluder.world);
+	}
+
+	ft_mutex_lock(local.occluder_mtx);
+	local.occluders.add(occluder);
+	ft_mutex_unlock(local.occluder_mtx);
+}
+
+///////////////////////////////////////////
+
+void render_add_mesh_instanced(mesh_t mesh, material_t material, const matrix *transforms, const color128 *colors_linear, int32_t count, render_layer_ layer) {
+	if (count <= 0) return;
+
+	// All instances go into a single contiguous span on the list, and the
+	// queue gets one item that references the whole span. The instance data
+	// is stored pre-transposed, so it can be copied straight into the
+	// instance buffer when the list is executed.
+	bool                  main_thread;
+	render_thread_list_t *slot;
+	_render_list_t       *list  = render_list_recording(&main_thread, &slot);
+	if (list == nullptr) return;
+	int32_t               start = list->instances.count;
+	if (list->instances.capacity < start + count)
+		list->instances.resize(maxi(start + count, list->instances.capacity * 2));
+
+	bool     use_hierarchy = main_thread && hierarchy_use_top();
+	XMMATRIX hierarchy     = XMMatrixIdentity();
+	if (use_hierarchy) math_matrix_to_fast(hierarchy_top(), &hierarchy);
+	bool     has_bounds    = !(mesh->bounds.dimensions.x == 0 && mesh->bounds.dimensions.y == 0 && mesh->bounds.dimensions.z == 0) && mesh->skin_data.bone_count == 0;
+	XMVECTOR bounds_min    = g_XMFltMax;
+	XMVECTOR bounds_max    = XMVectorNegate(g_XMFltMax);
+
+	render_item_t item;
+	for (int32_t i = 0; i < count; i++) {
+		XMMATRIX world;
+		math_matrix_to_fast(transforms[i], &world);
+		if (use_hierarchy) world = world * hierarchy;
+
+		if (has_bounds) {
+			render_item_set_bounds(&item, mesh, world);
+			bounds_min = XMVectorMin(bounds_min, item.bounds_center - item.bounds_extents);
+			bounds_max = XMVectorMax(bounds_max, item.bounds_center + item.bounds_extents);
+		}
+
+		list->instances.add(render_transform_buffer_t{
+			XMMatrixTranspose(world),
+			colors_linear == nullptr ? color128{ 1,1,1,1 } : colors_linear[i] });
+	}
+
+	item.mesh       = mesh;
+	item.mesh_inds  = mesh->ind_draw;
+	item.layer      = (uint16_t)layer;
+	item.inst_start = start;
+	item.inst_count = count;
+	if (has_bounds) {
+		item.bounds_center  = XMVectorScale(bounds_min + bounds_max, 0.5f);
+		item.bounds_extents = XMVectorScale(bounds_max - bounds_min, 0.5f);
+	} else {
+		item.bounds_center  = XMVectorZero();
+		item.bounds_extents = g_XMNegativeOne;
 	}
 
 	material_t curr = material;
 	while (curr != nullptr) {
 		item.material = curr;
-		item.sort_id  = render_sort_id(curr, mesh);
-		render_list_add(&item);
+		item.sort_id  = render_sort_id(curr, mesh, &item.sort);
+		render_list_add_to(list, &item);
 		curr = curr->chain;
 	}
+	render_list_recording_end(slot);
 }
 
 ///////////////////////////////////////////
 
 void render_add_model_mat(model_t model, material_t material_override, const matrix& transform, color128 color_linear, render_layer_ layer) {
+	// Drawing a model updates its animation and skin, which touches the
+	// model and the global animation list, so unlike render_add_mesh and
+	// render_add_mesh_instanced, this one is main thread only.
+	if (!sk_is_main_thread()) {
+		static bool warned = false;
+		if (!warned) log_err("render_add_model can only be called from the main thread, use render_add_mesh from other threads!");
+		warned = true;
+		return;
+	}
+
+	// On the main thread, this is always the active list and never a slot.
+	render_thread_list_t *slot;
+	_render_list_t       *list = render_list_recording(nullptr, &slot);
+	if (list == nullptr) return;
+
 	XMMATRIX root;
 	if (hierarchy_use_top()) {
 		matrix_mul(transform, hierarchy_top(), root);
@@ -683,23 +1279,53 @@ void render_add_model_mat(model_t model, material_t material_override, const mat
 		math_matrix_to_fast(transform, &root);
 	}
 
+	// Everything needed to turn a visual's bounds into screen coverage for
+	// LOD selection. This uses the primary camera, since views like mirrors
+	// and screenshots are recorded from the same list.
+	XMVECTOR lod_eye   = math_vec3_to_fast(input_head()->position);
+	float    lod_scale = 0;
+	if (local.projection_type == projection_perspective) {
+		fov_info_t fov = device_display_get_fov();
+		lod_scale = 2.0f / (tanf(fov.top * deg2rad) - tanf(fov.bottom * deg2rad));
+	} else {
+		lod_scale = 1.0f / local.ortho_viewport_height;
+	}
+
 	anim_update_model(model);
 	for (int32_t i = 0; i < model->visuals.count; i++) {
 		const model_visual_t *vis = &model->visuals[i];
 		if (vis->visible == false) continue;
 		
+		XMMATRIX world;
+		matrix_mul(vis->transform_model, root, world);
+
 		render_item_t item;
-		item.mesh      = vis->mesh;
-		item.mesh_inds = vis->mesh->ind_count;
-		item.color     = color_linear;
-		item.layer     = (uint16_t)layer;
-		matrix_mul(vis->transform_model, root, item.transform);
+		render_item_set_bounds(&item, vis->mesh, world);
+
+		// The LOD chain shares the bounds of the full detail mesh, which
+		// keeps culling and selection stable as the visual changes levels.
+		mesh_t     mesh     = vis->mesh;
+		material_t material = vis->material;
+		int32_t    lod      = render_model_lod(vis, &item, lod_eye, lod_scale);
+		if (lod > 0) {
+			const model_lod_t *level = &vis->lods[lod - 1];
+			if (level->mesh     == nullptr) continue;
+			if (level->material != nullptr) material = level->material;
+			mesh = level->mesh;
+		}
+		list->stats.lod_draws[lod < render_stats_lod_max ? lod : render_stats_lod_max - 1]++;
+
+		item.mesh       = mesh;
+		item.mesh_inds  = mesh->ind_count;
+		item.layer      = (uint16_t)layer;
+		item.inst_start = render_list_add_instance(list, world, color_linear);
+		item.inst_count = 1;
 
-		material_t curr = material_override == nullptr ? vis->material : material_override;
+		material_t curr = material_override == nullptr ? material : material_override;
 		while (curr != nullptr) {
 			item.material = curr;
-			item.sort_id  = render_sort_id(curr, vis->mesh);
-			render_list_add(&item);
+			item.sort_id  = render_sort_id(curr, mesh, &item.sort);
+			render_list_add_to(list, &item);
 			curr = curr->chain;
 		}
 	}
@@ -712,18 +1338,62 @@ void render_add_model_mat(model_t model, material_t material_override, const mat
 
 ///////////////////////////////////////////
 
+int32_t render_model_lod(const model_visual_t *vis, const render_item_t *item, XMVECTOR eye, float coverage_scale) {
+	// Skinned meshes are swapped out for an animated copy, and their LODs
+	// wouldn't follow along, so those always draw at full detail. Visuals
+	// with unbounded meshes can't be measured, so they stay at full detail
+	// as well.
+	if (vis->lods.count == 0 || vis->mesh->skin_data.bone_count > 0 || XMVectorGetX(item->bounds_extents) < 0)
+		return 0;
+
+	// Screen coverage is the fraction of the screen's height that the
+	// bounding sphere covers.
+	float radius   = XMVectorGetX(XMVector3Length(item->bounds_extents));
+	float coverage = 1;
+	if (local.projection_type == projection_perspective) {
+		float dist = XMVectorGetX(XMVector3Length(XMVectorSubtract(item->bounds_center, eye)));
+		if (dist > radius) coverage = radius * coverage_scale / dist;
+	} else {
+		coverage = radius * 2 * coverage_scale;
+	}
+
+	int32_t lod = 0;
+	while (lod < vis->lods.count && coverage < vis->lods[lod].screen_coverage)
+		lod++;
+	return lod;
+}
+
+///////////////////////////////////////////
+
 void render_add_model(model_t model, const matrix &transform, color128 color_linear, render_layer_ layer) {
 	render_add_model_mat(model, nullptr, transform, color_linear, layer);
 }
 
 ///////////////////////////////////////////
 
-void render_draw_queue(const matrix *views, const matrix *projections, render_layer_ filter, int32_t view_count) {
-	// Copy camera information into the global buffer
+// The global buffer is split in two: the camera block changes with each set
+// of views, and everything else only changes once a frame, or when the sky
+// changes. Drawing the same frame to several views only re-uploads the
+// buffer when the cameras actually differ, and the binds themselves stick
+// around until something could have disturbed them.
+void render_globals_set_camera(const matrix *views, const matrix *projections, int32_t view_count, XMMATRIX *out_viewprojs) {
+	if (local.global_buffer.view_count != (uint32_t)view_count) {
+		local.global_buffer.view_count = view_count;
+		local.global_dirty             = true;
+	}
+
 	for (int32_t i = 0; i < view_count; i++) {
 		XMMATRIX view_f, projection_f;
 		math_matrix_to_fast(views      [i], &view_f      );
 		math_matrix_to_fast(projections[i], &projection_f);
+		out_viewprojs[i] = view_f * projection_f;
+
+		XMMATRIX view_t = XMMatrixTranspose(view_f);
+		XMMATRIX proj_t = XMMatrixTranspose(projection_f);
+		if (!local.global_dirty &&
+			memcmp(&local.global_buffer.view[i], &view_t, sizeof(view_t)) == 0 &&
+			memcmp(&local.global_buffer.proj[i], &proj_t, sizeof(proj_t)) == 0)
+			continue;
 
 		XMMATRIX view_inv = XMMatrixInverse(nullptr, view_f      );
 		XMMATRIX proj_inv = XMMatrixInverse(nullptr, projection_f);
@@ -733,16 +1403,25 @@ void render_draw_queue(const matrix *views, const matrix *projections, render_la
 		XMStoreFloat3((XMFLOAT3*)&local.global_buffer.camera_pos[i], cam_pos);
 		XMStoreFloat3((XMFLOAT3*)&local.global_buffer.camera_dir[i], cam_dir);
 
-		local.global_buffer.view    [i] = XMMatrixTranspose(view_f);
-		local.global_buffer.proj    [i] = XMMatrixTranspose(projection_f);
+		local.global_buffer.view    [i] = view_t;
+		local.global_buffer.proj    [i] = proj_t;
 		local.global_buffer.proj_inv[i] = XMMatrixTranspose(proj_inv);
-		local.global_buffer.viewproj[i] = XMMatrixTranspose(view_f * projection_f);
+		local.global_buffer.viewproj[i] = XMMatrixTranspose(out_viewprojs[i]);
+		local.global_dirty = true;
 	}
+}
+
+///////////////////////////////////////////
+
+void render_globals_set_frame() {
+	uint64_t frame = time_frame();
+	if (local.global_frame == frame && !local.global_refresh) return;
+	local.global_frame   = frame;
+	local.global_refresh = false;
+	local.global_dirty   = true;
 
-	// Copy in the other global shader variables
 	memcpy(local.global_buffer.lighting, local.lighting, sizeof(vec4) * 9);
-	local.global_buffer.time       = time_totalf();
-	local.global_buffer.view_count = view_count;
+	local.global_buffer.time = time_totalf();
 	for (int32_t i = 0; i < handed_max; i++) {
 		const hand_t* hand = input_hand((handed_)i);
 		vec3          tip  = hand->tracked_state & button_state_active ? hand->fingers[1][4].position : vec3{ 0,-1000,0 };
@@ -755,34 +1434,112 @@ void render_draw_queue(const matrix *views, const matrix *projections, render_la
 	local.global_buffer.cubemap_i = sky_tex != nullptr
 		? vec4{ (float)sky_tex->width, (float)sky_tex->height, floorf(log2f((float)sky_tex->width)), 0 }
 		: vec4{};
+}
+
+///////////////////////////////////////////
 
-	// Upload shader globals and set them active!
-	material_buffer_set_data(local.shader_globals, &local.global_buffer);
+void render_globals_bind() {
+	// Upload shader globals if anything in them changed
+	if (local.global_dirty) {
+		material_buffer_set_data(local.shader_globals, &local.global_buffer);
+		local.global_dirty = false;
+	}
 
 	// Activate any material buffers we have
-	for (int32_t i = 0; i < _countof(material_buffers); i++) {
-		if (material_buffers[i].size != 0)
+	for (int32_t i = 0; i < (int32_t)_countof(material_buffers); i++) {
+		bool active = material_buffers[i].size != 0;
+		if (active && (!local.global_binds_valid || !local.global_bound_buffers[i]))
 			skg_buffer_bind(&material_buffers[i].buffer, { (uint16_t)i,  skg_stage_vertex | skg_stage_pixel, skg_register_constant }, 0);
+		local.global_bound_buffers[i] = active;
 	}
 
-	// Activate any global textures we have
-	for (int32_t i = 0; i < _countof(local.global_textures); i++) {
+	// Activate any global textures we have. Textures that are still loading
+	// bind their fallback, so this also catches the swap once they finish.
+	for (int32_t i = 0; i < (int32_t)_countof(local.global_textures); i++) {
+		const skg_tex_t *tex = nullptr;
 		if (local.global_textures[i] != nullptr) {
-			skg_tex_t *tex = local.global_textures[i]->fallback == nullptr
+			tex = local.global_textures[i]->fallback == nullptr
 				? &local.global_textures[i]->tex
 				: &local.global_textures[i]->fallback->tex;
-			skg_tex_bind(tex, { (uint16_t)i,  skg_stage_vertex | skg_stage_pixel, skg_register_resource });
+			if (!local.global_binds_valid || local.global_bound_textures[i] != tex)
+				skg_tex_bind(tex, { (uint16_t)i,  skg_stage_vertex | skg_stage_pixel, skg_register_resource });
 		}
+		local.global_bound_textures[i] = tex;
 	}
+	local.global_binds_valid = true;
+}
+
+///////////////////////////////////////////
 
-	render_list_execute(local.list_primary, filter, view_count, 0, INT_MAX);
+void render_globals_target(tex_t render_target) {
+	// Binding a texture as a render target unbinds it as a shader resource,
+	// so if it's also a global texture, it'll need bound again.
+	for (int32_t i = 0; i < (int32_t)_countof(local.global_textures); i++) {
+		if (local.global_textures[i] == render_target)
+			local.global_binds_valid = false;
+	}
+}
+
+///////////////////////////////////////////
+
+void render_draw_queue(const matrix *views, const matrix *projections, render_layer_ filter, int32_t view_count, material_t override_material, bool primary) {
+	XMMATRIX viewprojs[2];
+	render_globals_set_camera(views, projections, view_count, viewprojs);
+	render_cull_set_views    (viewprojs, view_count);
+	render_occlusion_prepare (viewprojs, view_count);
+
+	render_globals_set_frame();
+	render_globals_bind     ();
+
+	if (override_material != nullptr) {
+		render_list_execute_material(local.list_primary, filter, view_count, 0, INT_MAX, override_material);
+	} else if (!primary || !local.gpu_timing) {
+		render_list_execute(local.list_primary, filter, view_count, 0, INT_MAX);
+	} else {
+		// The primary view gets drawn a queue range at a time, so each range
+		// can be timed on its own. The sky sits at its own queue position
+		// in the middle of the opaque range.
+		int32_t sky_queue = local.sky_mat->alpha_mode*1000 + local.sky_mat->queue_offset;
+		struct { int32_t start, end; render_pass_ pass; } ranges[] = {
+			{ 0,             sky_queue,     render_pass_opaque },
+			{ sky_queue,     sky_queue + 1, render_pass_sky    },
+			{ sky_queue + 1, 2000,          render_pass_opaque },
+			{ 2000,          3000,          render_pass_blend  },
+			{ 3000,          INT_MAX,       render_pass_add    } };
+		for (int32_t i = 0; i < (int32_t)_countof(ranges); i++) {
+			int32_t timer = render_gpu_begin(ranges[i].pass);
+			render_list_execute(local.list_primary, filter, view_count, ranges[i].start, ranges[i].end);
+			render_gpu_end(timer);
+		}
+	}
 }
 
 ///////////////////////////////////////////
 
 void render_draw_matrix(const matrix* views, const matrix* projections, int32_t count, render_layer_ render_filter) {
+	// Sort the primary list against the primary view before anything else
+	// gets drawn, so depth sorting is relative to the user's eyes.
+	render_list_merge_threads(local.list_primary);
+	math_matrix_to_fast(views[0], &local.sort_view);
+	render_list_prep(local.list_primary);
+	render_list_prep_retained();
+	render_check_viewpoints();
+	render_draw_queue(views, projections, render_filter, count, nullptr, true);
+	render_check_screenshots();
+}
+
+///////////////////////////////////////////
+
+// Without a display there's no primary view to draw, but render_to and
+// screenshots still need somewhere to happen. This is what lets
+// display_mode_none render to textures.
+void render_draw_offscreen() {
+	skg_draw_begin();
+	render_list_merge_threads(local.list_primary);
+	math_matrix_to_fast(local.camera_root_final_inv, &local.sort_view);
+	render_list_prep(local.list_primary);
+	render_list_prep_retained();
 	render_check_viewpoints();
-	render_draw_queue(views, projections, render_filter, count);
 	render_check_screenshots();
 }
 
@@ -791,6 +1548,11 @@ void render_draw_matrix(const matrix* views, const matrix* projections, int32_t
 // The screenshots are produced in FIFO order, meaning the
 // order of screenshot requests by users is preserved.
 void render_check_screenshots() {
+	// Hand over any screenshots from earlier frames that the GPU is done
+	// with, before queueing up new ones.
+	render_capture_poll(false);
+	render_capture_trim();
+	render_file_writer_poll();
 	if (local.screenshot_list.count == 0) return;
 
 	skg_tex_t *old_target = skg_tex_target_get();
@@ -798,16 +1560,13 @@ void render_check_screenshots() {
 		int32_t  w = local.screenshot_list[i].width;
 		int32_t  h = local.screenshot_list[i].height;
 
-		// Create the screenshot surface
-		size_t   size   = sizeof(color32) * w * h;
-		color32 *buffer = (color32*)sk_malloc(size);
-
-		tex_t render_capture_surface = tex_create(tex_type_image_nomips | tex_type_rendertarget, local.screenshot_list[i].tex_format);
-		tex_set_color_arr(render_capture_surface, w, h, nullptr, 1, nullptr, 8);
-		tex_release(tex_add_zbuffer(render_capture_surface));
-
-		// Setup to render the screenshot
-		skg_tex_target_bind(&render_capture_surface->tex);
+		// Setup to render the screenshot. Both the render target and the
+		// resolve texture are pooled, and can be reused right away, since
+		// the readback copy happens in order on the GPU.
+		render_capture_target_t *capture = render_capture_target(w, h, local.screenshot_list[i].tex_format);
+		tex_t                    target  = render_target_pool_get(w, h, local.screenshot_list[i].tex_format, 8);
+		int32_t                  timer   = render_gpu_begin(render_pass_screenshot);
+		skg_tex_target_bind(&target->tex);
 
 		// Set up the viewport if we've got one!
 		if (local.screenshot_list[i].viewport.w != 0) {
@@ -837,34 +1596,315 @@ void render_check_screenshots() {
 		}
 
 		// Render!
-		render_draw_queue(&local.screenshot_list[i].camera, &local.screenshot_list[i].projection, local.screenshot_list[i].layer_filter, 1);
+		render_draw_queue(&local.screenshot_list[i].camera, &local.screenshot_list[i].projection, local.screenshot_list[i].layer_filter, 1, nullptr, false);
 		skg_tex_target_bind(nullptr);
 
-		tex_t resolve_tex = tex_create(tex_type_image_nomips, local.screenshot_list[i].tex_format);
-		tex_set_colors(resolve_tex, w, h, nullptr);
-		skg_tex_copy_to(&render_capture_surface->tex, &resolve_tex->tex);
-		tex_get_data(resolve_tex, buffer, size);
+		// Resolve, and start copying it back to the CPU. The data shows up
+		// in render_capture_poll a few frames from now.
+		render_capture_t pending = {};
+		pending.render_on_screenshot_callback = local.screenshot_list[i].render_on_screenshot_callback;
+		pending.context  = local.screenshot_list[i].context;
+		pending.frame    = time_frame();
+		pending.readback = render_capture_readback(&capture->resolve->tex);
+		skg_tex_copy_to   (&target->tex, &capture->resolve->tex);
+		skg_readback_start(&pending.readback, &capture->resolve->tex);
+		render_gpu_end(timer);
+		local.capture_pending.add(pending);
+		render_target_pool_return(target);
+	}
+	local.screenshot_list.clear();
+	skg_tex_target_bind(old_target);
+}
+
+///////////////////////////////////////////
+
+void render_capture_poll(bool flush) {
+	// Screenshots are delivered in the order they were requested, so this
+	// stops at the first one that isn't ready yet. If one has been waiting
+	// too long, we'll just wait on the GPU for it.
+	uint64_t frame = time_frame();
+	int32_t  done  = 0;
+	for (; done < local.capture_pending.count; done++) {
+		render_capture_t *capture = &local.capture_pending[done];
+		if (!flush && frame - capture->frame < render_capture_latency && !skg_readback_ready(&capture->readback))
+			break;
+
+		int32_t w    = capture->readback.width;
+		int32_t h    = capture->readback.height;
+		size_t  size = (size_t)w * h * skg_tex_fmt_size(capture->readback.format);
+		if (local.capture_buffer_size < size) {
+			sk_free(local.capture_buffer);
+			local.capture_buffer      = (color32*)sk_malloc(size);
+			local.capture_buffer_size = size;
+		}
+		skg_readback_get_contents(&capture->readback, local.capture_buffer, size);
 #if defined(SKG_OPENGL)
-		int32_t line_size = skg_tex_fmt_size(resolve_tex->tex.format) * resolve_tex->tex.width;
-		void* tmp = sk_malloc(line_size);
-		for (int32_t y = 0; y < resolve_tex->tex.height / 2; y++) {
-			void* top_line = ((uint8_t*)buffer) + line_size * y;
-			void* bot_line = ((uint8_t*)buffer) + line_size * ((resolve_tex->tex.height - 1) - y);
+		int32_t line_size = (int32_t)(w * skg_tex_fmt_size(capture->readback.format));
+		void*   tmp       = sk_malloc(line_size);
+		for (int32_t y = 0; y < h / 2; y++) {
+			void* top_line = ((uint8_t*)local.capture_buffer) + line_size * y;
+			void* bot_line = ((uint8_t*)local.capture_buffer) + line_size * ((h - 1) - y);
 			memcpy(tmp, top_line, line_size);
 			memcpy(top_line, bot_line, line_size);
 			memcpy(bot_line, tmp, line_size);
 		}
 		sk_free(tmp);
 #endif
-		tex_release(render_capture_surface);
-		tex_release(resolve_tex);
+		local.capture_readbacks.add({ capture->readback, frame });
 
 		// Notify that the color data is ready!
-		local.screenshot_list[i].render_on_screenshot_callback(buffer, w, h, local.screenshot_list[i].context);
-		sk_free(buffer);
+		capture->render_on_screenshot_callback(local.capture_buffer, w, h, capture->context);
 	}
-	local.screenshot_list.clear();
-	skg_tex_target_bind(old_target);
+	if (done > 0) {
+		for (int32_t i = done; i < local.capture_pending.count; i++)
+			local.capture_pending[i - done] = local.capture_pending[i];
+		local.capture_pending.count -= done;
+	}
+}
+
+///////////////////////////////////////////
+
+render_capture_target_t *render_capture_target(int32_t width, int32_t height, tex_format_ format) {
+	uint64_t frame = time_frame();
+	for (int32_t i = 0; i < local.capture_targets.count; i++) {
+		render_capture_target_t *target = &local.capture_targets[i];
+		if (target->width == width && target->height == height && target->format == format) {
+			target->frame = frame;
+			return target;
+		}
+	}
+
+	render_capture_target_t result = {};
+	result.width   = width;
+	result.height  = height;
+	result.format  = format;
+	result.frame   = frame;
+	result.resolve = tex_create(tex_type_image_nomips, format);
+	tex_set_colors(result.resolve, width, height, nullptr);
+	// Creating a texture can bind it over the top of one of ours
+	local.global_binds_valid = false;
+	return &local.capture_targets[local.capture_targets.add(result)];
+}
+
+///////////////////////////////////////////
+
+skg_readback_t render_capture_readback(const skg_tex_t *tex) {
+	// Readbacks are in flight for a few frames, so there can be several of
+	// these per capture target.
+	for (int32_t i = local.capture_readbacks.count - 1; i >= 0; i--) {
+		skg_readback_t readback = local.capture_readbacks[i].readback;
+		if (readback.width == tex->width && readback.height == tex->height && readback.format == tex->format) {
+			local.capture_readbacks.remove(i);
+			return readback;
+		}
+	}
+	return skg_readback_create(tex->format, tex->width, tex->height);
+}
+
+///////////////////////////////////////////
+
+void render_capture_trim() {
+	// Continuous capture reuses the same few targets every frame, so
+	// anything that hasn't been touched in a while isn't needed anymore.
+	uint64_t frame = time_frame();
+	for (int32_t i = local.capture_targets.count - 1; i >= 0; i--) {
+		if (frame - local.capture_targets[i].frame < render_capture_keep) continue;
+		tex_release(local.capture_targets[i].resolve);
+		local.capture_targets.remove(i);
+	}
+	for (int32_t i = local.capture_readbacks.count - 1; i >= 0; i--) {
+		if (frame - local.capture_readbacks[i].frame < render_capture_keep) continue;
+		skg_readback_destroy(&local.capture_readbacks[i].readback);
+		local.capture_readbacks.remove(i);
+	}
+}
+
+///////////////////////////////////////////
+
+// Transient render targets, for things like portals and mirrors that need
+// an intermediate surface every frame. A target handed out here belongs to
+// the caller until the end of the frame, and is then free for anyone asking
+// for the same size and format. Targets nobody has asked for in a few frames
+// get released.
+tex_t render_target_pool_get(int32_t width, int32_t height, tex_format_ format, int32_t multisample) {
+	if (multisample < 1) multisample = 1;
+
+	uint64_t frame = time_frame();
+	for (int32_t i = 0; i < local.target_pool.count; i++) {
+		render_target_entry_t *entry = &local.target_pool[i];
+		if (!entry->in_use &&
+			entry->width       == width  &&
+			entry->height      == height &&
+			entry->format      == format &&
+			entry->multisample == multisample) {
+			entry->in_use = true;
+			entry->frame  = frame;
+			local.target_pool_hits++;
+			local.target_pool_frame_hits++;
+			return entry->target;
+		}
+	}
+
+	render_target_entry_t result = {};
+	result.width       = width;
+	result.height      = height;
+	result.format      = format;
+	result.multisample = multisample;
+	result.frame       = frame;
+	result.in_use      = true;
+	result.target      = tex_create(tex_type_image_nomips | tex_type_rendertarget, format);
+	tex_set_color_arr(result.target, width, height, nullptr, 1, nullptr, multisample);
+	tex_release(tex_add_zbuffer(result.target));
+	local.global_binds_valid = false;
+	local.target_pool.add(result);
+	local.target_pool_misses++;
+	local.target_pool_frame_misses++;
+	return result.target;
+}
+
+///////////////////////////////////////////
+
+void render_target_pool_return(tex_t target) {
+	for (int32_t i = 0; i < local.target_pool.count; i++) {
+		if (local.target_pool[i].target == target) {
+			local.target_pool[i].in_use = false;
+			return;
+		}
+	}
+}
+
+///////////////////////////////////////////
+
+void render_target_pool_frame() {
+	uint64_t frame = time_frame();
+	for (int32_t i = local.target_pool.count - 1; i >= 0; i--) {
+		render_target_entry_t *entry = &local.target_pool[i];
+		entry->in_use = false;
+		if (frame - entry->frame < render_target_keep) continue;
+		tex_release(entry->target);
+		local.target_pool.remove(i);
+	}
+}
+
+///////////////////////////////////////////
+
+// GPU timings come from timestamp queries, which take a frame or two to
+// come back. Each frame keeps its own list of timers in a small ring, and a
+// frame's times are published once every timer in it has landed. Frames
+// that take too long are dropped rather than waited on, this never stalls
+// on the GPU.
+int32_t render_gpu_begin(render_pass_ pass) {
+	if (!local.gpu_timing) return -1;
+
+	render_gpu_timer_t timer = {};
+	timer.pass = pass;
+	if (local.gpu_timer_pool.count > 0) {
+		timer.timer = local.gpu_timer_pool.last();
+		local.gpu_timer_pool.pop();
+	} else {
+		timer.timer = skg_timer_create();
+		if (!skg_timer_is_valid(&timer.timer)) {
+			log_warn("GPU timer creation failed, GPU render stats are unavailable.");
+			local.gpu_timing = false;
+			return -1;
+		}
+	}
+
+	render_gpu_frame_t *frame = &local.gpu_frames[local.gpu_frame_curr];
+	if (frame->timers.count == 0)
+		frame->frame = time_frame();
+	skg_timer_begin(&timer.timer);
+	return frame->timers.add(timer);
+}
+
+///////////////////////////////////////////
+
+void render_gpu_end(int32_t timer) {
+	if (timer < 0) return;
+	skg_timer_end(&local.gpu_frames[local.gpu_frame_curr].timers[timer].timer);
+}
+
+///////////////////////////////////////////
+
+bool render_gpu_resolve(render_gpu_frame_t *frame) {
+	for (int32_t i = 0; i < frame->timers.count; i++) {
+		if (!skg_timer_ready(&frame->timers[i].timer)) return false;
+	}
+
+	float pass_ms[render_pass_max] = {};
+	float total_ms = 0;
+	bool  valid    = true;
+	for (int32_t i = 0; i < frame->timers.count; i++) {
+		float ms = 0;
+		if (skg_timer_get_ms(&frame->timers[i].timer, &ms)) {
+			pass_ms[frame->timers[i].pass] += ms;
+			total_ms                       += ms;
+		} else {
+			valid = false;
+		}
+		local.gpu_timer_pool.add(frame->timers[i].timer);
+	}
+	frame->timers.clear();
+
+	if (valid) {
+		memcpy(local.gpu_pass_ms, pass_ms, sizeof(pass_ms));
+		local.gpu_total_ms = total_ms;
+		local.gpu_ms_frame = frame->frame;
+	}
+	return true;
+}
+
+///////////////////////////////////////////
+
+void render_gpu_frame() {
+	if (!local.gpu_timing) return;
+
+	// Oldest first, so the newest finished frame is the one that sticks
+	const int32_t count = _countof(local.gpu_frames);
+	for (int32_t i = 1; i < count; i++) {
+		render_gpu_frame_t *frame = &local.gpu_frames[(local.gpu_frame_curr + i) % count];
+		if (frame->timers.count > 0)
+			render_gpu_resolve(frame);
+	}
+
+	// Whatever is still in the slot we're about to record into has been in
+	// flight for too long, so its timers just get reused.
+	local.gpu_frame_curr = (local.gpu_frame_curr + 1) % count;
+	render_gpu_frame_t *next = &local.gpu_frames[local.gpu_frame_curr];
+	for (int32_t i = 0; i < next->timers.count; i++)
+		local.gpu_timer_pool.add(next->timers[i].timer);
+	next->timers.clear();
+}
+
+///////////////////////////////////////////
+
+render_frame_stats_t render_stats_frame() {
+	return local.frame_stats;
+}
+
+///////////////////////////////////////////
+
+bool32_t render_stats_gpu_available() {
+	return local.gpu_timing;
+}
+
+///////////////////////////////////////////
+
+float render_stats_gpu_ms(render_pass_ pass) {
+	if (pass < 0 || pass >= render_pass_max) return 0;
+	return local.gpu_pass_ms[pass];
+}
+
+///////////////////////////////////////////
+
+float render_stats_gpu_total_ms() {
+	return local.gpu_total_ms;
+}
+
+///////////////////////////////////////////
+
+uint64_t render_stats_gpu_frame() {
+	return local.gpu_ms_frame;
 }
 
 ///////////////////////////////////////////
@@ -875,7 +1915,9 @@ void render_check_viewpoints() {
 	skg_tex_t *old_target = skg_tex_target_get();
 	for (int32_t i = 0; i < local.viewpoint_list.count; i++) {
 		// Setup to render the screenshot
-		skg_tex_target_bind(&local.viewpoint_list[i].rendertarget->tex);
+		int32_t timer = render_gpu_begin(render_pass_viewpoint);
+		skg_tex_target_bind  (&local.viewpoint_list[i].rendertarget->tex);
+		render_globals_target(local.viewpoint_list[i].rendertarget);
 
 		// Clear the viewport
 		if (local.viewpoint_list[i].clear != render_clear_none) {
@@ -900,11 +1942,14 @@ void render_check_viewpoints() {
 		}
 
 		// Render!
-		render_draw_queue(&local.viewpoint_list[i].camera, &local.viewpoint_list[i].projection, local.viewpoint_list[i].layer_filter, 1);
+		render_draw_queue(&local.viewpoint_list[i].camera, &local.viewpoint_list[i].projection, local.viewpoint_list[i].layer_filter, 1, local.viewpoint_list[i].override_material, false);
 		skg_tex_target_bind(nullptr);
+		render_gpu_end(timer);
 
-		// Release the reference we added, the user should have their own ref
+		// Release the references we added, the user should have their own
 		tex_release(local.viewpoint_list[i].rendertarget);
+		if (local.viewpoint_list[i].override_material != nullptr)
+			material_release(local.viewpoint_list[i].override_material);
 	}
 	local.viewpoint_list.clear();
 	skg_tex_target_bind(old_target);
@@ -913,18 +1958,45 @@ void render_check_viewpoints() {
 ///////////////////////////////////////////
 
 void render_clear() {
-	//log_infof("draws: %d, instances: %d, material: %d, shader: %d, texture %d, mesh %d", render_stats.draw_calls, render_stats.draw_instances, render_stats.swaps_material, render_stats.swaps_shader, render_stats.swaps_texture, render_stats.swaps_mesh);
-	render_list_clear(local.list_active);
+	// Keep the frame's stats around, clearing the list resets them
+	const render_stats_t *stats = &local.lists[local.list_primary].stats;
+	local.frame_stats.draw_calls           = stats->draw_calls;
+	local.frame_stats.draw_instances       = stats->draw_instances;
+	local.frame_stats.swaps_mesh           = stats->swaps_mesh;
+	local.frame_stats.swaps_material       = stats->swaps_material;
+	local.frame_stats.swaps_texture        = stats->swaps_texture;
+	local.frame_stats.culled               = stats->culled;
+	local.frame_stats.occluded             = stats->occluded;
+	local.frame_stats.instance_ring_size   = stats->instance_ring_size;
+	local.frame_stats.instance_ring_stalls = stats->instance_ring_stalls;
+	for (int32_t i = 0; i < render_stats_lod_max; i++)
+		local.frame_stats.lod_draws[i] = stats->lod_draws[i];
+	local.frame_stats.target_pool_hits     = local.target_pool_frame_hits;
+	local.frame_stats.target_pool_misses   = local.target_pool_frame_misses;
+	local.target_pool_frame_hits   = 0;
+	local.target_pool_frame_misses = 0;
+	render_list_clear(local.list_primary);
+	local.list_retained_prepped = false;
 
 	local.last_material = nullptr;
 	local.last_shader   = nullptr;
 	local.last_mesh     = nullptr;
+
+	render_target_pool_frame();
+	render_gpu_frame();
+	local.occluders.clear();
+
+	// Other code gets a turn at the GPU between frames, so global binds
+	// don't carry over from one frame to the next.
+	local.global_binds_valid = false;
+	assets_frame_end(false);
 }
 
 ///////////////////////////////////////////
 
 void render_blit_to_bound(material_t material) {
 	material_check_dirty(material);
+	int32_t timer = render_gpu_begin(render_pass_blit);
 
 	// Wipe our swapchain color and depth target clean, and then set them up for rendering!
 	float color[4] = { 0,0,0,0 };
@@ -947,6 +2019,7 @@ void render_blit_to_bound(material_t material) {
 	
 	// And draw to it!
 	skg_draw(0, 0, local.blit_quad->ind_count, 1);
+	render_gpu_end(timer);
 
 	local.last_material = nullptr;
 	local.last_mesh     = nullptr;
@@ -958,9 +2031,10 @@ void render_blit_to_bound(material_t material) {
 void render_blit(tex_t to, material_t material) {
 	skg_tex_t *old_target = skg_tex_target_get();
 
-	skg_tex_target_bind (&to->tex  );
-	render_blit_to_bound(material  );
-	skg_tex_target_bind (old_target);
+	skg_tex_target_bind  (&to->tex  );
+	render_globals_target(to        );
+	render_blit_to_bound (material  );
+	skg_tex_target_bind  (old_target);
 }
 
 ///////////////////////////////////////////
@@ -974,25 +2048,187 @@ void render_screenshot(const char* file_utf8, vec3 from_viewpt, vec3 at, int wid
 struct screenshot_ctx_t {
 	char*   filename;
 	int32_t quality;
+	void  (*on_complete)(const char *file_utf8, bool32_t success, void *context);
+	void   *context;
 };
 
+// Runs on the main thread as part of screenshot delivery, so this only
+// copies the color data and hands it off to the file writer thread. The
+// capture buffer gets reused by the next screenshot, so it can't be kept.
 void render_save_to_file(color32* color_buffer, int width, int height, void* context) {
 	screenshot_ctx_t *ctx = (screenshot_ctx_t*)context;
-	if (string_endswith(ctx->filename, ".png", false)) {
-		stbi_write_png(ctx->filename, width, height, 4, color_buffer, 0);
+
+	render_file_job_t job = {};
+	job.filename     = ctx->filename;
+	job.quality      = ctx->quality;
+	job.width        = width;
+	job.height       = height;
+	job.on_complete  = ctx->on_complete;
+	job.context      = ctx->context;
+	job.color_buffer = sk_malloc_t(color32, (size_t)width * height);
+	memcpy(job.color_buffer, color_buffer, sizeof(color32) * width * height);
+	sk_free(ctx);
+
+	render_file_writer_init();
+	if (!local.file_writer.running) {
+		// No worker thread on this platform, so encode it right here.
+		job.success = render_file_encode(&job);
+		sk_free(job.color_buffer);
+		job.color_buffer = nullptr;
+		local.file_writer.finished.add(job);
+		return;
+	}
+
+	ft_mutex_lock(local.file_writer.mtx);
+	local.file_writer.jobs.add(job);
+	ft_condition_signal(local.file_writer.work_ready);
+	ft_mutex_unlock(local.file_writer.mtx);
+}
+
+///////////////////////////////////////////
+
+bool32_t render_file_encode(const render_file_job_t *job) {
+	bool32_t result = false;
+	if (string_endswith(job->filename, ".png", false)) {
+		result = stbi_write_png(job->filename, job->width, job->height, 4, job->color_buffer, 0) != 0;
+	} else if (string_endswith(job->filename, ".qoi", false)) {
+		qoi_desc desc = {};
+		desc.width      = (uint32_t)job->width;
+		desc.height     = (uint32_t)job->height;
+		desc.channels   = 4;
+		desc.colorspace = QOI_SRGB;
+		int32_t size = 0;
+		void   *data = qoi_encode(job->color_buffer, &desc, &size);
+		if (data != nullptr) {
+			result = platform_write_file(job->filename, data, size);
+			free(data);
+		}
 	} else {
-		stbi_write_jpg(ctx->filename, width, height, 4, color_buffer, ctx->quality);
+		result = stbi_write_jpg(job->filename, job->width, job->height, 4, job->color_buffer, job->quality) != 0;
 	}
-	sk_free(ctx->filename);
-	sk_free(ctx);
+
+	if (!result) log_warnf("Couldn't write screenshot to %s", job->filename);
+	return result;
+}
+
+///////////////////////////////////////////
+
+int32_t render_file_writer_thread(void *) {
+	render_file_writer_t *writer = &local.file_writer;
+
+	ft_mutex_lock(writer->mtx);
+	while (true) {
+		// Quitting still finishes off any files that are queued up.
+		if (writer->jobs.count == 0) {
+			if (writer->quit) break;
+			ft_condition_wait(writer->work_ready, writer->mtx);
+			continue;
+		}
+
+		render_file_job_t job = writer->jobs[0];
+		writer->jobs.remove(0);
+		ft_mutex_unlock(writer->mtx);
+
+		job.success = render_file_encode(&job);
+		sk_free(job.color_buffer);
+		job.color_buffer = nullptr;
+
+		ft_mutex_lock(writer->mtx);
+		writer->finished.add(job);
+	}
+	writer->running = false;
+	ft_mutex_unlock(writer->mtx);
+	return 0;
+}
+
+///////////////////////////////////////////
+
+void render_file_writer_init() {
+	render_file_writer_t *writer = &local.file_writer;
+	if (writer->initialized) return;
+	writer->initialized = true;
+
+#if !defined(__EMSCRIPTEN__)
+	writer->mtx        = ft_mutex_create();
+	writer->work_ready = ft_condition_create();
+	writer->running    = true;
+	ft_thread_t thread = ft_thread_create(render_file_writer_thread, nullptr);
+	fr_thread_name(thread, "StereoKit Screenshot");
+#endif
+}
+
+///////////////////////////////////////////
+
+void render_file_writer_shutdown() {
+	render_file_writer_t *writer = &local.file_writer;
+	if (!writer->initialized) return;
+
+	if (writer->mtx != nullptr) {
+		ft_mutex_lock(writer->mtx);
+		writer->quit = true;
+		ft_condition_broadcast(writer->work_ready);
+		ft_mutex_unlock(writer->mtx);
+
+		while (true) {
+			ft_mutex_lock(writer->mtx);
+			bool running = writer->running;
+			ft_mutex_unlock(writer->mtx);
+			if (!running) break;
+			ft_yield();
+		}
+	}
+
+	// Everything's written now, let the callers know.
+	render_file_writer_poll();
+
+	if (writer->mtx != nullptr) {
+		ft_condition_destroy(&writer->work_ready);
+		ft_mutex_destroy    (&writer->mtx);
+	}
+	writer->jobs    .free();
+	writer->finished.free();
+	*writer = {};
+}
+
+///////////////////////////////////////////
+
+// Completion callbacks happen here on the main thread, rather than on the
+// writer thread, so they're free to call back into StereoKit.
+void render_file_writer_poll() {
+	render_file_writer_t *writer = &local.file_writer;
+	if (writer->mtx != nullptr) {
+		ft_mutex_lock(writer->mtx);
+		if (writer->finished.count == 0) {
+			ft_mutex_unlock(writer->mtx);
+			return;
+		}
+	}
+	array_t<render_file_job_t> finished = writer->finished;
+	writer->finished = {};
+	if (writer->mtx != nullptr) ft_mutex_unlock(writer->mtx);
+
+	for (int32_t i = 0; i < finished.count; i++) {
+		if (finished[i].on_complete)
+			finished[i].on_complete(finished[i].filename, finished[i].success, finished[i].context);
+		sk_free(finished[i].filename);
+	}
+	finished.free();
 }
 
 ///////////////////////////////////////////
 
 void render_screenshot_pose(const char* file_utf8, int32_t file_quality_100, pose_t viewpoint, int width, int height, float fov_degrees) {
+	render_screenshot_file(file_utf8, file_quality_100, viewpoint, width, height, fov_degrees, nullptr, nullptr);
+}
+
+///////////////////////////////////////////
+
+void render_screenshot_file(const char* file_utf8, int32_t file_quality_100, pose_t viewpoint, int width, int height, float fov_degrees, void (*on_complete)(const char *file_utf8, bool32_t success, void *context), void *context) {
 	screenshot_ctx_t *ctx = sk_malloc_t(screenshot_ctx_t, 1);
-	ctx->filename = string_copy(file_utf8);
-	ctx->quality  = file_quality_100;
+	ctx->filename    = string_copy(file_utf8);
+	ctx->quality     = file_quality_100;
+	ctx->on_complete = on_complete;
+	ctx->context     = context;
 
 	matrix view = matrix_invert(pose_matrix(viewpoint));
 	matrix proj = matrix_perspective(fov_degrees, (float)width / height, local.clip_planes.x, local.clip_planes.y);
@@ -1016,6 +2252,31 @@ void render_screenshot_viewpoint(void (*render_on_screenshot_callback)(color32*
 
 ///////////////////////////////////////////
 
+void render_screenshot_viewpoints(void (*render_on_screenshot_callback)(color32* color_buffer, int width, int height, void* context), const screenshot_view_t *views, int32_t view_count) {
+	// Each view gets its own callback, in the same order as the views.
+	for (int32_t i = 0; i < view_count; i++) {
+		const screenshot_view_t *view = &views[i];
+		matrix inv_cam = matrix_invert(view->camera);
+		local.screenshot_list.add(render_screenshot_t{ render_on_screenshot_callback, view->context, inv_cam, view->projection, view->viewport, view->width, view->height, view->layer_filter, view->clear, view->tex_format });
+	}
+}
+
+///////////////////////////////////////////
+
+tex_t render_transient_target(int32_t width, int32_t height, tex_format_ color_format, int32_t multisample) {
+	if (width <= 0 || height <= 0) {
+		log_err("render_transient_target needs a size larger than zero!");
+		return nullptr;
+	}
+	// Like other asset getters, the caller gets their own reference. The
+	// pool only hands this target to someone else once the frame is over.
+	tex_t result = render_target_pool_get(width, height, color_format, multisample);
+	tex_addref(result);
+	return result;
+}
+
+///////////////////////////////////////////
+
 void render_to(tex_t to_rendertarget, const matrix &camera, const matrix &projection, render_layer_ layer_filter, render_clear_ clear, rect_t viewport) {
 	render_material_to(to_rendertarget, nullptr, camera, projection, layer_filter, clear, viewport);
 }
@@ -1028,6 +2289,8 @@ void render_material_to(tex_t to_rendertarget, material_t override_material, con
 		return;
 	}
 	tex_addref(to_rendertarget);
+	if (override_material != nullptr)
+		material_addref(override_material);
 
 	matrix inv_cam;
 	matrix_inverse(camera, inv_cam);
@@ -1071,24 +2334,48 @@ void render_set_material(material_t material) {
 
 ///////////////////////////////////////////
 
-skg_buffer_t *render_fill_inst_buffer(array_t<render_transform_buffer_t> &list, int32_t &offset, int32_t &out_count) {
-	// Find a buffer that can contain this list! Or the biggest one
-	int32_t size  = list.count - offset;
-	int32_t start = offset;
+skg_buffer_t *render_inst_ring_next(_render_list_t *list, uint32_t size_bytes) {
+	// Buffers in the ring are handed out in order, and a buffer written in
+	// the last few frames may still be in use by the GPU. Rather than
+	// overwrite it and wait on the driver, we grow the ring with a fresh
+	// buffer. If the ring is already at its limit, stomping a ring buffer
+	// would force a sync with whatever draw last read it, so we fall back
+	// to a single dynamic overflow buffer, and leave renaming it to the
+	// driver's discard path. That's counted as a stall.
+	uint64_t frame = time_frame();
+	int32_t  next  = local.instance_ring_curr + 1 >= local.instance_ring.count ? 0 : local.instance_ring_curr + 1;
+	render_inst_buffer *slot = nullptr;
+	if (local.instance_ring.count == 0 || frame - local.instance_ring[next].frame < render_instance_frames) {
+		if (local.instance_ring.count < render_instance_ring_max) {
+			next = local.instance_ring.count == 0 ? 0 : local.instance_ring_curr + 1;
+			local.instance_ring.insert(next, {});
+		} else {
+			list->stats.instance_ring_stalls++;
+			slot = &local.instance_overflow;
+		}
+	}
 
-	// Check if it fits, if it doesn't, then set up data so we only fill what we have!
-	if (size > render_instance_max) {
-		offset   += render_instance_max;
-		out_count = render_instance_max;
-	} else {
-		// this means we've gotten through the whole list :)
-		offset    = 0;
-		out_count = size;
+	if (slot == nullptr) {
+		slot = &local.instance_ring[next];
+		local.instance_ring_curr = next;
+	}
+	if (slot->max < size_bytes) {
+		// Grow geometrically so a frame that slowly gets busier doesn't
+		// recreate buffers every frame, and keep it a multiple of one
+		// shader constant.
+		uint32_t size = maxi(size_bytes, slot->max * 2);
+		size = ((size + 15) / 16) * 16;
+		skg_buffer_destroy(&slot->buffer);
+		slot->buffer = skg_buffer_create(nullptr, size / 16, 16, skg_buffer_type_constant, skg_use_dynamic);
+		slot->max    = size;
+#if !defined(SKG_OPENGL) && (defined(_DEBUG) || defined(SK_GPU_LABELS))
+		skg_buffer_name(&slot->buffer, "sk/render/instance_buffer");
+#endif
 	}
+	slot->frame = frame;
 
-	// Copy data into the buffer, and return it!
-	skg_buffer_set_contents(&local.instance_buffer, &list[start], sizeof(render_transform_buffer_t) * out_count);
-	return &local.instance_buffer;
+	list->stats.instance_ring_size = local.instance_ring.count;
+	return &slot->buffer;
 }
 
 ///////////////////////////////////////////
@@ -1127,6 +2414,102 @@ void render_get_device(void **device, void **context) {
 #endif
 }
 
+///////////////////////////////////////////
+// Culling                               //
+///////////////////////////////////////////
+
+void render_item_set_bounds(render_item_t *item, mesh_t mesh, const XMMATRIX &world) {
+	// Meshes with empty bounds (the text, line and sprite batches skip bounds
+	// calculation) and skinned meshes (whose bounds don't follow their
+	// animation) can't be reliably culled, so they're always visible.
+	if ((mesh->bounds.dimensions.x == 0 && mesh->bounds.dimensions.y == 0 && mesh->bounds.dimensions.z == 0) || mesh->skin_data.bone_count > 0) {
+		item->bounds_center  = world.r[3];
+		item->bounds_extents = g_XMNegativeOne;
+		return;
+	}
+
+	// Transform the local AABB into a world space AABB that contains it.
+	XMVECTOR extents = XMVectorScale(math_vec3_to_fast(mesh->bounds.dimensions), 0.5f);
+	item->bounds_center  = XMVector3Transform(math_vec3_to_fast(mesh->bounds.center), world);
+	item->bounds_extents =
+		XMVectorAbs(XMVectorMultiply(XMVectorSplatX(extents), world.r[0])) +
+		XMVectorAbs(XMVectorMultiply(XMVectorSplatY(extents), world.r[1])) +
+		XMVectorAbs(XMVectorMultiply(XMVectorSplatZ(extents), world.r[2]));
+}
+
+///////////////////////////////////////////
+
+void render_cull_set_views(const XMMATRIX *viewprojs, int32_t view_count) {
+	local.cull_view_count = view_count;
+	for (int32_t v = 0; v < view_count; v++) {
+		// Planes are extracted from the columns of the view projection
+		// matrix. The near plane is skipped, since it depends on the depth
+		// range convention of the projection, and the side planes already
+		// catch anything behind the viewer.
+		XMMATRIX cols = XMMatrixTranspose(viewprojs[v]);
+		local.cull_planes[v][0] = cols.r[3] + cols.r[0]; // left
+		local.cull_planes[v][1] = cols.r[3] - cols.r[0]; // right
+		local.cull_planes[v][2] = cols.r[3] + cols.r[1]; // bottom
+		local.cull_planes[v][3] = cols.r[3] - cols.r[1]; // top
+		local.cull_planes[v][4] = cols.r[3] - cols.r[2]; // far
+	}
+}
+
+///////////////////////////////////////////
+
+bool render_cull_visible(const render_item_t *item) {
+	if (XMVectorGetX(item->bounds_extents) < 0) return true;
+
+	// An item is visible if any one of the views can see it, which gives us
+	// the union of the stereo frustums.
+	XMVECTOR center = XMVectorSetW(item->bounds_center, 1);
+	for (int32_t v = 0; v < local.cull_view_count; v++) {
+		bool inside = true;
+		for (int32_t p = 0; p < 5; p++) {
+			XMVECTOR plane  = local.cull_planes[v][p];
+			float    dist   = XMVectorGetX(XMVector4Dot (center, plane));
+			float    radius = XMVectorGetX(XMVector3Dot(item->bounds_extents, XMVectorAbs(plane)));
+			if (dist + radius < 0) { inside = false; break; }
+		}
+		if (inside) return true;
+	}
+	return local.cull_view_count == 0;
+}
+
+///////////////////////////////////////////
+
+void render_occlusion_prepare(const XMMATRIX *viewprojs, int32_t view_count) {
+	local.occlusion_view_count = 0;
+	if (local.occluders.count == 0) return;
+
+	if (local.occlusion_depth == nullptr)
+		local.occlusion_depth = sk_malloc_t(float, (size_t)render_occlusion_width * render_occlusion_height * 2);
+
+	for (int32_t v = 0; v < view_count && v < 2; v++) {
+		occlusion_buffer_t *buffer = &local.occlusion[v];
+		occlusion_begin(buffer, local.occlusion_depth + (size_t)render_occlusion_width * render_occlusion_height * v, render_occlusion_width, render_occlusion_height, viewprojs[v]);
+		for (int32_t i = 0; i < local.occluders.count; i++) {
+			mesh_t mesh = local.occluders[i].mesh;
+			occlusion_rasterize(buffer, mesh->verts, sizeof(vert_t), mesh->vert_count, mesh->inds, mesh->ind_count, local.occluders[i].world);
+		}
+	}
+	local.occlusion_view_count = view_count < 2 ? view_count : 2;
+}
+
+///////////////////////////////////////////
+
+bool render_occlusion_visible(const render_item_t *item) {
+	if (local.occlusion_view_count == 0 || XMVectorGetX(item->bounds_extents) < 0) return true;
+
+	// Like frustum culling, this is the union of what the views can see.
+	for (int32_t v = 0; v < local.occlusion_view_count; v++) {
+		if (occlusion_visible(&local.occlusion[v], item->bounds_center, item->bounds_extents))
+			return true;
+	}
+	return false;
+}
+
+///////////////////////////////////////////
 ///////////////////////////////////////////
 // Render List                           //
 ///////////////////////////////////////////
@@ -1140,8 +2523,41 @@ render_list_t render_list_create() {
 
 ///////////////////////////////////////////
 
+bool render_list_valid(render_list_t list, const char *function) {
+	if (list < 0 || list >= local.lists.count || local.lists[list].state == render_list_state_destroyed) {
+		log_errf("%s: %d isn't a valid render list!", function, list);
+		return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////
+
 void render_list_release(render_list_t list) {
-	local.lists[list].queue.free();
+	if (!render_list_valid(list, "render_list_release")) return;
+	if (list == local.list_primary) {
+		log_err("render_list_release: The primary render list can't be released!");
+		return;
+	}
+	if (local.list_stack.index_of(list) >= 0) {
+		log_err("render_list_release: This render list is still pushed, call render_list_pop first!");
+		return;
+	}
+	render_list_destroy(list);
+}
+
+///////////////////////////////////////////
+
+void render_list_destroy(render_list_t list) {
+	if (local.lists[list].state == render_list_state_destroyed) return;
+
+	render_list_set_retained(list, false);
+	render_list_clear       (list);
+	local.lists[list].queue    .free();
+	local.lists[list].sorted   .free();
+	local.lists[list].instances.free();
+	local.lists[list].queue_offsets.free();
+	local.lists[list].sorted_mesh  .free();
 	local.lists[list] = {};
 	local.lists[list].state = render_list_state_destroyed;
 }
@@ -1149,152 +2565,341 @@ void render_list_release(render_list_t list) {
 ///////////////////////////////////////////
 
 void render_list_push(render_list_t list) {
-	local.list_active = local.list_stack.add(list);
+	if (!render_list_valid(list, "render_list_push")) return;
+
+	local.list_stack.add(list);
+	local.list_active = list;
 	local.lists[list].state = render_list_state_used;
 }
 
 ///////////////////////////////////////////
 
 void render_list_pop() {
+	if (local.list_stack.count <= 1) {
+		log_err("render_list_pop called more times than render_list_push!");
+		return;
+	}
 	local.list_stack.pop();
-	local.list_active = local.list_stack.count - 1;
+	local.list_active = local.list_stack.last();
 }
 
 ///////////////////////////////////////////
 
 void render_list_add(const render_item_t *item) {
-	local.lists[local.list_active].queue.add(*item);
-	assets_addref(&item->material->header);
-	assets_addref(&item->mesh->header);
+	render_thread_list_t *slot;
+	_render_list_t       *list = render_list_recording(nullptr, &slot);
+	if (list == nullptr) return;
+	render_list_add_to(list, item);
+	render_list_recording_end(slot);
 }
 
 ///////////////////////////////////////////
 
-void render_list_add_to(render_list_t list, const render_item_t *item) {
-	local.lists[list].queue.add(*item);
-	assets_addref(&item->material->header);
-	assets_addref(&item->mesh->header);
+void render_list_add_to(_render_list_t *list, const render_item_t *item) {
+	list->queue.add(*item);
+	list->prepped = false;
+	if (item->sort == render_sort_back_to_front)
+		list->back_to_front = true;
+
+	// Lists that outlive the frame need to keep their assets alive. The
+	// others rely on assets_frame_end to keep released assets around until
+	// the frame is done with them.
+	if (!list->borrowed) {
+		assets_addref(&item->material->header);
+		assets_addref(&item->mesh->header);
+	}
 }
 
 ///////////////////////////////////////////
 
-inline void render_list_execute_run(_render_list_t *list, material_t material, const skg_mesh_t *mesh, int32_t mesh_inds, uint32_t view_count) {
-	render_set_material(material);
-	skg_mesh_bind      (mesh);
-	list->stats.swaps_mesh++;
+int32_t render_list_add_instance(_render_list_t *list, const XMMATRIX &world, color128 color) {
+	return list->instances.add(render_transform_buffer_t{ XMMatrixTranspose(world), color });
+}
 
-	// Collect and draw instances
-	int32_t offsets = 0, inst_count = 0;
-	do {
-		skg_buffer_t *instances = render_fill_inst_buffer(local.instance_list, offsets, inst_count);
-		skg_buffer_bind(instances, render_list_inst_bind, 0);
+///////////////////////////////////////////
+
+_render_list_t *render_list_recording(bool *out_main_thread, render_thread_list_t **out_slot) {
+	*out_slot = nullptr;
 
-		skg_draw(0, 0, mesh_inds, inst_count * view_count);
-		list->stats.draw_calls     += 1;
-		list->stats.draw_instances += inst_count;
+	// The main thread records into whatever list is on top of the stack.
+	if (sk_is_main_thread()) {
+		if (out_main_thread) *out_main_thread = true;
+		return &local.lists[local.list_active];
+	}
+	if (out_main_thread) *out_main_thread = false;
+
+	// Other threads each get their own list. The slots never move, so a
+	// thread can find its own list without the table mutex, which is only
+	// needed when a thread claims a slot. The slot's own mutex is held
+	// while the item is recorded, see render_list_recording_end. It's only
+	// ever contended by render_list_merge_threads, which may also have freed
+	// the slot between the lookup and the lock, so it's checked again.
+	ft_id_t id    = ft_id_current();
+	int32_t count = atomic_read(&local.thread_list_count);
+	for (int32_t i = 0; i < count; i++) {
+		render_thread_list_t *thread_list = &local.thread_lists[i];
+		if (!atomic_read(&thread_list->in_use) || !ft_id_equal(thread_list->thread, id)) continue;
+
+		ft_mutex_lock(thread_list->mtx);
+		if (thread_list->in_use && ft_id_equal(thread_list->thread, id)) {
+			*out_slot = thread_list;
+			return &thread_list->list;
+		}
+		ft_mutex_unlock(thread_list->mtx);
+		break;
+	}
 
-	} while (offsets != 0);
+	ft_mutex_lock(local.thread_list_mtx);
+	int32_t slot = -1;
+	for (int32_t i = 0; i < local.thread_list_count; i++) {
+		if (local.thread_lists[i].in_use == 0) { slot = i; break; }
+	}
+	if (slot == -1 && local.thread_list_count < (int32_t)_countof(local.thread_lists))
+		slot = local.thread_list_count;
+	if (slot != -1) {
+		render_thread_list_t *thread_list = &local.thread_lists[slot];
+		ft_mutex_lock(thread_list->mtx);
+		thread_list->thread = id;
+		thread_list->frame  = time_frame();
+		thread_list->list   = {};
+		thread_list->list.borrowed = true;
+		atomic_increment(&thread_list->in_use);
+		if (slot == local.thread_list_count)
+			atomic_increment(&local.thread_list_count);
+		*out_slot = thread_list;
+	}
+	ft_mutex_unlock(local.thread_list_mtx);
+
+	// If we're out of slots, there's no safe place to put items from this
+	// thread, so callers will skip them.
+	if (*out_slot == nullptr) {
+		static bool warned = false;
+		if (!warned) log_err("Too many threads are submitting render items, items from extra threads will be skipped!");
+		warned = true;
+		return nullptr;
+	}
+	return &(*out_slot)->list;
 }
 
 ///////////////////////////////////////////
 
-void render_list_execute(render_list_t list_id, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end) {
-	_render_list_t *list = &local.lists[list_id];
-	list->state = render_list_state_rendering;
+void render_list_recording_end(render_thread_list_t *slot) {
+	if (slot != nullptr) ft_mutex_unlock(slot->mtx);
+}
 
-	if (list->queue.count == 0) {
-		list->state = render_list_state_rendered; 
-		return;
-	}
-	render_list_prep(list_id);
-	uint64_t sort_id_start = render_sort_id_from_queue(queue_start);
-	uint64_t sort_id_end   = render_sort_id_from_queue(queue_end);
+///////////////////////////////////////////
 
-	render_item_t *run_start = nullptr;
-	for (int32_t i = 0; i < list->queue.count; i++) {
-		render_item_t *item = &list->queue[i];
-		
-		// Skip this item if it's filtered out
-		if ((item->layer & filter) == 0 || item->sort_id < sort_id_start) continue;
-		// End early if we're past the end of the desired queue range
-		if (item->sort_id >= sort_id_end) break;
+void render_list_merge_threads(render_list_t list_id) {
+	// Items recorded on other threads are appended to the primary list
+	// before it gets sorted. Each slot is locked while it's moved over, so
+	// a thread that's recording right now just waits, and its items land in
+	// the next frame. Holding the table mutex means no slot gets claimed
+	// while we might be freeing it.
+	_render_list_t *list  = &local.lists[list_id];
+	uint64_t        frame = time_frame();
+	ft_mutex_lock(local.thread_list_mtx);
+	for (int32_t t = 0; t < local.thread_list_count; t++) {
+		render_thread_list_t *slot        = &local.thread_lists[t];
+		_render_list_t       *thread_list = &slot->list;
+		if (slot->in_use == 0) continue;
 
-		// If it's the first in the run, record the material/mesh
-		if (run_start == nullptr) {
-			run_start = item;
+		ft_mutex_lock(slot->mtx);
+		// Threads that have stopped recording give their slot back, so
+		// short lived threads don't use up the table over time.
+		if (thread_list->queue.count == 0) {
+			if (frame - slot->frame > render_thread_list_keep) {
+				thread_list->queue    .free();
+				thread_list->instances.free();
+				slot->thread = {};
+				atomic_decrement(&slot->in_use);
+			}
+			ft_mutex_unlock(slot->mtx);
+			continue;
 		}
-		// If the material/mesh changed
-		else if (run_start->material != item->material || run_start->mesh != item->mesh) {
-			// Render the run that just ended
-			render_list_execute_run(list, run_start->material, &run_start->mesh->gpu_mesh, run_start->mesh_inds, view_count);
-			local.instance_list.clear();
-			// Start the next run
-			run_start = item;
+		slot->frame = frame;
+
+		int32_t inst_offset = list->instances.count;
+		int32_t item_offset = list->queue.count;
+		list->instances.add_range(thread_list->instances.data, thread_list->instances.count);
+		list->queue.add_range(thread_list->queue.data, thread_list->queue.count);
+		for (int32_t i = item_offset; i < list->queue.count; i++) {
+			list->queue[i].inst_start += inst_offset;
 		}
+		list->prepped = false;
 
-		// Add the current item to the run of instances
-		XMMATRIX transpose = XMMatrixTranspose(item->transform);
-		local.instance_list.add(render_transform_buffer_t{ transpose, item->color });
+		// Both lists borrow their assets for the frame, so there are no
+		// references to move over, and this list can just be emptied.
+		thread_list->queue    .clear();
+		thread_list->instances.clear();
+		ft_mutex_unlock(slot->mtx);
 	}
-	// Render the last remaining run, which won't be triggered by the loop's
-	// conditions
-	if (local.instance_list.count > 0) {
-		render_list_execute_run(list, run_start->material, &run_start->mesh->gpu_mesh, run_start->mesh_inds, view_count);
-		local.instance_list.clear();
+	ft_mutex_unlock(local.thread_list_mtx);
+}
+
+///////////////////////////////////////////
+
+inline void render_list_stage_run(const render_item_t *run_start, material_t material, int32_t inst_start) {
+	local.instance_runs.add(render_inst_run_t{ material, run_start->mesh, run_start->mesh_inds, inst_start, local.instance_list.count - inst_start });
+
+	// Pad the staged instances so the next run starts at an offset that can
+	// be bound directly.
+	int32_t aligned = ((local.instance_list.count + render_instance_align - 1) / render_instance_align) * render_instance_align;
+	if (local.instance_list.capacity < aligned)
+		local.instance_list.resize(maxi(aligned, local.instance_list.capacity * 2));
+	local.instance_list.count = aligned;
+}
+
+///////////////////////////////////////////
+
+void render_list_execute_runs(_render_list_t *list, uint32_t view_count) {
+	if (local.instance_runs.count == 0) return;
+
+	// With range binding, all instance data for the whole execute goes up in
+	// a single write, and each draw binds a window into it. Otherwise, each
+	// draw gets its own buffer from the ring.
+	skg_buffer_t *buffer = nullptr;
+	if (local.instance_bind_range) {
+		uint32_t size = local.instance_list.count * sizeof(render_transform_buffer_t);
+		buffer = render_inst_ring_next(list, size + render_instance_window);
+		skg_buffer_set_contents(buffer, local.instance_list.data, size);
 	}
 
-	list->state = render_list_state_rendered;
+	for (int32_t r = 0; r < local.instance_runs.count; r++) {
+		const render_inst_run_t *run = &local.instance_runs[r];
+		render_set_material(run->material);
+		skg_mesh_bind      (&run->mesh->gpu_mesh);
+		list->stats.swaps_mesh++;
+
+		for (int32_t offset = 0; offset < run->inst_count; offset += render_instance_chunk) {
+			int32_t  inst_count = mini(render_instance_chunk, run->inst_count - offset);
+			uint32_t inst_start = (uint32_t)(run->inst_start + offset);
+			if (local.instance_bind_range) {
+				skg_buffer_bind_range(buffer, render_list_inst_bind, inst_start * sizeof(render_transform_buffer_t), render_instance_window);
+			} else {
+				buffer = render_inst_ring_next(list, render_instance_window);
+				skg_buffer_set_contents(buffer, &local.instance_list[inst_start], inst_count * sizeof(render_transform_buffer_t));
+				skg_buffer_bind        (buffer, render_list_inst_bind, 0);
+			}
+
+			skg_draw(0, 0, run->mesh_inds, inst_count * view_count);
+			list->stats.draw_calls     += 1;
+			list->stats.draw_instances += inst_count;
+		}
+	}
+	local.instance_runs.clear();
+	local.instance_list.clear();
+}
+
+///////////////////////////////////////////
+
+void render_list_execute(render_list_t list_id, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end) {
+	render_list_execute_merged(list_id, filter, view_count, queue_start, queue_end, nullptr);
 }
 
 ///////////////////////////////////////////
 
 void render_list_execute_material(render_list_t list_id, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end, material_t override_material) {
+	// With only one material, items are walked in mesh order instead, see
+	// render_list_prep_mesh.
+	material_check_dirty(override_material);
+	render_list_execute_merged(list_id, filter, view_count, queue_start, queue_end, override_material);
+}
+
+///////////////////////////////////////////
+
+void render_list_execute_merged(render_list_t list_id, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end, material_t override_material) {
 	_render_list_t *list = &local.lists[list_id];
 	list->state = render_list_state_rendering;
 
-	if (list->queue.count == 0) {
+	// The primary list draws all retained lists along with it. Each list is
+	// already sorted, so they get merged as we walk through them, rather
+	// than combined and sorted again. Retained lists are prepped once per
+	// frame by render_list_prep_retained, so here they're only read.
+	_render_list_t    *sources[render_retained_max + 1];
+	render_sort_key_t *keys   [render_retained_max + 1];
+	int32_t            cursors[render_retained_max + 1] = {};
+	int32_t            ends   [render_retained_max + 1] = {};
+	int32_t            source_count = 0;
+	if (list->queue.count > 0) {
+		render_list_prep(list_id);
+		sources[source_count++] = list;
+	}
+	if (list_id == local.list_primary) {
+		for (int32_t i = 0; i < local.list_retained.count; i++) {
+			_render_list_t *retained = &local.lists[local.list_retained[i]];
+			if (retained->queue.count == 0 || !retained->prepped) continue;
+			sources[source_count++] = retained;
+		}
+	}
+	if (source_count == 0) {
 		list->state = render_list_state_rendered;
 		return;
 	}
-	// TODO: this isn't entirely optimal here, this would be best if sorted
-	// solely by the mesh id since we only have one single material.
-	render_list_prep(list_id);
-	material_check_dirty(override_material);
 	uint64_t sort_id_start = render_sort_id_from_queue(queue_start);
 	uint64_t sort_id_end   = render_sort_id_from_queue(queue_end);
 
+	// Jump straight to the part of each list that's in the queue range,
+	// rather than walking over everything that comes before it. Both orders
+	// are sorted by queue first, so they share the same queue offsets.
+	for (int32_t s = 0; s < source_count; s++) {
+		if (override_material != nullptr) {
+			render_list_prep_mesh(sources[s]);
+			keys[s] = sources[s]->sorted_mesh.data;
+		} else {
+			keys[s] = sources[s]->sorted.data;
+		}
+		cursors[s] = render_list_queue_offset(sources[s], sort_id_start);
+		ends   [s] = render_list_queue_offset(sources[s], sort_id_end);
+	}
+
 	render_item_t *run_start = nullptr;
-	for (int32_t i = 0; i < list->queue.count; i++) {
-		render_item_t *item = &list->queue[i];
+	int32_t        run_inst  = 0;
+	while (true) {
+		// Find the source with the lowest sort id next in line. Anything at
+		// or past the end of the queue range is never picked, so we're done
+		// when nothing is found.
+		int32_t  src  = -1;
+		uint64_t best = sort_id_end;
+		for (int32_t s = 0; s < source_count; s++) {
+			if (cursors[s] < ends[s] && keys[s][cursors[s]].sort_id < best) {
+				best = keys[s][cursors[s]].sort_id;
+				src  = s;
+			}
+		}
+		if (src == -1) break;
+		_render_list_t *item_list = sources[src];
+		render_item_t  *item      = &item_list->queue[keys[src][cursors[src]].index];
+		cursors[src] += 1;
 
 		// Skip this item if it's filtered out
-		if ((item->layer & filter) == 0 || item->sort_id < sort_id_start) continue;
-		// End early if we're past the end of the desired queue range
-		if (item->sort_id >= sort_id_end) break;
+		if ((item->layer & filter) == 0) continue;
+		// Skip this item if no view can see it
+		if (!render_cull_visible(item)) { list->stats.culled++; continue; }
+		// Skip this item if it's hidden behind occluders in every view
+		if (!render_occlusion_visible(item)) { list->stats.occluded++; continue; }
 
 		// If it's the first in the run, record the material/mesh
 		if (run_start == nullptr) {
 			run_start = item;
 		}
-		// If the mesh changed
-		else if (run_start->mesh != item->mesh) {
-			// Render the run that just ended
-			render_list_execute_run(list, override_material, &run_start->mesh->gpu_mesh, run_start->mesh_inds, view_count);
-			local.instance_list.clear();
+		// If the material/mesh changed. With an override material, only the
+		// mesh matters.
+		else if ((override_material == nullptr && run_start->material != item->material) || run_start->mesh != item->mesh) {
+			// Stage the run that just ended
+			render_list_stage_run(run_start, override_material ? override_material : run_start->material, run_inst);
 			// Start the next run
 			run_start = item;
+			run_inst  = local.instance_list.count;
 		}
 
-		// Add the current item to the run of instances
-		XMMATRIX transpose = XMMatrixTranspose(item->transform);
-		local.instance_list.add(render_transform_buffer_t{ transpose, item->color });
-	}
-	// Render the last remaining run, which won't be triggered by the loop's
-	// conditions
-	if (local.instance_list.count > 0) {
-		render_list_execute_run(list, override_material, &run_start->mesh->gpu_mesh, run_start->mesh_inds, view_count);
-		local.instance_list.clear();
+		// Add the current item's instances to the run
+		local.instance_list.add_range(&item_list->instances[item->inst_start], item->inst_count);
 	}
+	// Stage the last remaining run, which won't be triggered by the loop's
+	// conditions, then draw everything that was staged
+	if (run_start != nullptr)
+		render_list_stage_run(run_start, override_material ? override_material : run_start->material, run_inst);
+	render_list_execute_runs(list, view_count);
 
 	list->state = render_list_state_rendered;
 }
@@ -1303,16 +2908,45 @@ void render_list_execute_material(render_list_t list_id, render_layer_ filter, u
 
 void render_list_prep(render_list_t list_id) {
 	_render_list_t *list = &local.lists[list_id];
-	if (list->prepped) return;
 
-	// Sort the render queue
-	radix_sort7(&list->queue[0], list->queue.count);
+	// Retained lists stay sorted between frames, but materials on them can
+	// still change, so those always need checked. Back to front sorting
+	// changes as the camera moves, so those get sorted every frame.
+	if (list->prepped && !list->retained) return;
+
+	// Sort the render queue, after updating each item's depth. Only the
+	// small key/index pairs get sorted, the items themselves stay put.
+	if (!list->prepped || list->back_to_front) {
+		if (list->sorted.capacity < list->queue.count)
+			list->sorted.resize(list->queue.count);
+		list->sorted.count = list->queue.count;
+
+		for (int32_t i = 0; i < list->queue.count; i++) {
+			render_item_t *item  = &list->queue[i];
+			float          depth = -XMVectorGetZ(XMVector3Transform(item->bounds_center, local.sort_view));
+			item->sort_id = render_sort_id_depth(item->sort_id, item->sort, depth);
+			list->sorted[i] = { item->sort_id, (uint32_t)i };
+		}
+		render_sort_keys(list->sorted.data, list->sorted.count);
+		list->prepped_mesh = false;
+
+		// Note where each queue starts, so executing a queue range can skip
+		// right to it.
+		const uint64_t queue_mask = 0xFFFFull << 48;
+		list->queue_offsets.clear();
+		for (int32_t i = 0; i < list->sorted.count; i++) {
+			uint64_t queue = list->sorted[i].sort_id & queue_mask;
+			if (list->queue_offsets.count == 0 || list->queue_offsets.last().sort_id != queue)
+				list->queue_offsets.add({ queue, i });
+		}
+	}
 
 	// Make sure the material buffers are all up-to-date
 	material_t curr = nullptr;
-	for (int32_t i = 0; i < list->queue.count; i++) {
-		if (curr == list->queue[i].material) continue;
-		curr = list->queue[i].material;
+	for (int32_t i = 0; i < list->sorted.count; i++) {
+		material_t material = list->queue[list->sorted[i].index].material;
+		if (curr == material) continue;
+		curr = material;
 		material_check_dirty(curr);
 	}
 
@@ -1321,137 +2955,235 @@ void render_list_prep(render_list_t list_id) {
 
 ///////////////////////////////////////////
 
-void render_list_clear(render_list_t list) {
-	for (int32_t i = 0; i < local.lists[list].queue.count; i++) {
-		assets_releaseref(&local.lists[list].queue[i].material->header);
-		assets_releaseref(&local.lists[list].queue[i].mesh->header);
+void render_list_prep_retained() {
+	// Every view that draws the primary list draws the retained lists too,
+	// so they only need sorted and checked the first time in a frame.
+	if (local.list_retained_prepped) return;
+	for (int32_t i = 0; i < local.list_retained.count; i++) {
+		if (local.lists[local.list_retained[i]].queue.count > 0)
+			render_list_prep(local.list_retained[i]);
 	}
-	local.lists[list].queue.clear();
-	local.lists[list].stats   = {};
-	local.lists[list].prepped = false;
-	local.lists[list].state   = render_list_state_empty;
+	local.list_retained_prepped = true;
 }
 
-///////////////////////////////////////////
-// Radix render sorting!                 //
 ///////////////////////////////////////////
 
-// https://travisdowns.github.io/blog/2019/05/22/sorting.html
+void render_list_prep_mesh(_render_list_t *list) {
+	// Override materials draw everything with the same material, so the
+	// only thing that can break up an instanced run is the mesh. This builds
+	// a second order that keeps the queue, but puts the mesh right after it.
+	// It's built from the regular order, and the sort is stable, so items
+	// sharing a mesh stay in state/depth order. This sticks around until the
+	// list gets sorted again.
+	if (list->prepped_mesh) return;
 
-#if _MSC_VER
-#include <intrin.h>
-#endif
+	if (list->sorted_mesh.capacity < list->sorted.count)
+		list->sorted_mesh.resize(list->sorted.count);
+	list->sorted_mesh.count = list->sorted.count;
 
-const size_t   RADIX_BITS   = 8;
-const size_t   RADIX_SIZE   = (size_t)1 << RADIX_BITS;
-const size_t   RADIX_LEVELS = (63 / RADIX_BITS) + 1;
-const uint64_t RADIX_MASK   = RADIX_SIZE - 1;
+	const uint64_t queue_mask = 0xFFFFull << 48;
+	for (int32_t i = 0; i < list->sorted.count; i++) {
+		render_sort_key_t key  = list->sorted[i];
+		uint64_t          mesh = list->queue[key.index].mesh->header.index & 0xFFFF;
+		list->sorted_mesh[i] = { (key.sort_id & queue_mask) | (mesh << 32), key.index };
+	}
+	render_sort_keys(list->sorted_mesh.data, list->sorted_mesh.count);
+	list->prepped_mesh = true;
+}
 
-using freq_array_type = size_t [RADIX_LEVELS][RADIX_SIZE];
+///////////////////////////////////////////
 
-// Since this sort is specifically for the render queue, we'll reserve a
-// chunk of memory that sticks around, and resizes if it's too small.
-render_item_t *radix_queue_area = nullptr;
-size_t         radix_queue_size = 0;
+void render_list_clear(render_list_t list) {
+	if (!render_list_valid(list, "render_list_clear")) return;
 
-void radix_sort_init() {
-	radix_queue_area = nullptr;
-	radix_queue_size = 0;
+	if (!local.lists[list].borrowed) {
+		for (int32_t i = 0; i < local.lists[list].queue.count; i++) {
+			assets_releaseref(&local.lists[list].queue[i].material->header);
+			assets_releaseref(&local.lists[list].queue[i].mesh->header);
+		}
+	}
+	local.lists[list].queue    .clear();
+	local.lists[list].sorted   .clear();
+	local.lists[list].instances.clear();
+	local.lists[list].queue_offsets.clear();
+	local.lists[list].sorted_mesh  .clear();
+	local.lists[list].prepped_mesh = false;
+	local.lists[list].stats   = {};
+	local.lists[list].prepped = false;
+	local.lists[list].back_to_front = false;
+	local.lists[list].state   = render_list_state_empty;
 }
 
-void radix_sort_clean() {
-	sk_free(radix_queue_area);
-	radix_queue_area = nullptr;
-	radix_queue_size = 0;
-}
+///////////////////////////////////////////
 
-// never inline just to make it show up easily in profiles (inlining this lengthly function doesn't
-// really help anyways)
-static void count_frequency(render_item_t *a, size_t count, freq_array_type freqs) {
-	for (size_t i = 0; i < count; i++) {
-		uint64_t value = a[i].sort_id;
-		for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
-			freqs[pass][value & RADIX_MASK]++;
-			value >>= RADIX_BITS;
-		}
+void render_list_set_retained(render_list_t list, bool32_t retained) {
+	if (!render_list_valid(list, "render_list_set_retained")) return;
+	if (retained && list == local.list_primary) {
+		log_err("The primary render list can't be retained!");
+		return;
 	}
-}
 
-/**
-* Determine if the frequencies for a given level are "trivial".
-* 
-* Frequencies are trivial if only a single frequency has non-zero
-* occurrences. In that case, the radix step just acts as a copy so we can
-* skip it.
-*/
-static bool is_trivial(size_t freqs[RADIX_SIZE], size_t count) {
-	for (size_t i = 0; i < RADIX_SIZE; i++) {
-		size_t freq = freqs[i];
-		if (freq != 0) {
-			return freq == count;
+	// Retained lists keep their items until cleared, and are drawn with the
+	// primary list every frame.
+	int32_t index = local.list_retained.index_of(list);
+	if (retained && index < 0) {
+		if (local.list_retained.count >= render_retained_max) {
+			log_errf("Only %d render lists can be retained at once!", render_retained_max);
+			return;
 		}
+		local.list_retained.add(list);
+	} else if (!retained && index >= 0) {
+		local.list_retained.remove(index);
 	}
-	assert(count == 0); // we only get here if count was zero
-	return true;
+	local.lists[list].retained = retained;
 }
 
-void radix_sort7(render_item_t *a, size_t count) {
-	// Resize up if needed
-	if (radix_queue_size < count) {
-		sk_free(radix_queue_area);
-		radix_queue_area = sk_malloc_t(render_item_t, count);
-		radix_queue_size = count;
+///////////////////////////////////////////
+
+int32_t render_list_queue_offset(const _render_list_t *list, uint64_t sort_id) {
+	// Index of the first sorted item at or past sort_id's queue. sort_id is
+	// expected to be from render_sort_id_from_queue.
+	int32_t at = list->queue_offsets.binary_search(&render_queue_offset_t::sort_id, sort_id);
+	if (at < 0) at = ~at;
+	return at < list->queue_offsets.count
+		? list->queue_offsets[at].start
+		: list->sorted.count;
+}
+
+///////////////////////////////////////////
+
+void render_sort_keys(render_sort_key_t *keys, size_t count) {
+	// The scratch area sticks around, and resizes if it's too small.
+	if (local.sort_scratch_size < count) {
+		sk_free(local.sort_scratch);
+		local.sort_scratch      = sk_malloc_t(render_sort_key_t, count);
+		local.sort_scratch_size = count;
+	}
+
+	// Big queues get split across the sort pool, which is only spun up the
+	// first time a queue gets large enough to need it.
+	if (count < render_sort_mt_min) {
+		radix_sort7(keys, local.sort_scratch, count);
+		return;
 	}
-	freq_array_type freqs = {};
-	count_frequency(a, count, freqs);
+	render_sort_pool_init();
+
+	int32_t jobs = local.sort_pool.thread_count + 1;
+	if (jobs > (int32_t)(count / render_sort_mt_chunk)) jobs = (int32_t)(count / render_sort_mt_chunk);
+	radix_sort7_mt(keys, local.sort_scratch, count, local.sort_pool.work, jobs, render_sort_pool_dispatch);
+}
 
-	render_item_t *from = a, *to = radix_queue_area;
+///////////////////////////////////////////
 
-	for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
+int32_t render_sort_pool_thread(void *) {
+	render_sort_pool_t *pool = &local.sort_pool;
 
-		if (is_trivial(freqs[pass], count)) {
-			// this pass would do nothing, just skip it
+	ft_mutex_lock(pool->mtx);
+	while (!pool->quit) {
+		if (pool->job_next >= pool->job_count) {
+			ft_condition_wait(pool->work_ready, pool->mtx);
 			continue;
 		}
 
-		uint64_t shift = pass * RADIX_BITS;
+		int32_t job_idx = pool->job_next++;
+		ft_mutex_unlock(pool->mtx);
+		pool->job(pool->job_ctx, job_idx);
+		ft_mutex_lock(pool->mtx);
 
-		// array of pointers to the current position in each queue, which we set up based on the
-		// known final sizes of each queue (i.e., "tighly packed")
-		render_item_t *queue_ptrs[RADIX_SIZE], *next = to;
-		for (size_t i = 0; i < RADIX_SIZE; i++) {
-			queue_ptrs[i] = next;
-			next += freqs[pass][i];
-		}
+		pool->job_finished++;
+		if (pool->job_finished == pool->job_count)
+			ft_condition_signal(pool->work_done);
+	}
+	pool->thread_running--;
+	ft_mutex_unlock(pool->mtx);
+	return 0;
+}
 
-		// copy each element into the appropriate queue based on the current RADIX_BITS sized
-		// "digit" within it
-		for (size_t i = 0; i < count; i++) {
-			render_item_t value = from[i];
-			size_t        index = (value.sort_id >> shift) & RADIX_MASK;
-			*queue_ptrs[index]++ = value;
-#ifdef _MSC_VER
-	#if defined(_M_ARM) || defined(_M_ARM64)
-			__prefetch (queue_ptrs[index] + 1);
-	#else
-			_m_prefetch(queue_ptrs[index] + 1);
-	#endif
+///////////////////////////////////////////
+
+void render_sort_pool_init() {
+	render_sort_pool_t *pool = &local.sort_pool;
+	if (pool->initialized) return;
+	pool->initialized = true;
+
+	// One core is already busy with this thread.
+#if defined(__EMSCRIPTEN__)
+	pool->thread_count = 0;
 #else
-			__builtin_prefetch(queue_ptrs[index] + 1);
+	pool->thread_count = ft_processor_count() - 1;
+	if (pool->thread_count > RADIX_MT_MAX_JOBS - 1) pool->thread_count = RADIX_MT_MAX_JOBS - 1;
+	if (pool->thread_count < 0)                     pool->thread_count = 0;
 #endif
-		}
+	if (pool->thread_count == 0) return;
 
-		// swap from and to areas
-		render_item_t *tmp = to;
-		to   = from;
-		from = tmp;
+	pool->mtx        = ft_mutex_create();
+	pool->work_ready = ft_condition_create();
+	pool->work_done  = ft_condition_create();
+	pool->work       = sk_malloc_t(radix_mt_work_t, 1);
+
+	pool->thread_running = pool->thread_count;
+	for (int32_t i = 0; i < pool->thread_count; i++) {
+		ft_thread_t thread = ft_thread_create(render_sort_pool_thread, nullptr);
+		fr_thread_name(thread, "StereoKit Sort");
 	}
+}
+
+///////////////////////////////////////////
 
-	// because of the last swap, the "from" area has the sorted payload: if it's
-	// not the original array "a", do a final copy
-	if (from != a) {
-		memcpy(a, from, count*sizeof(render_item_t));
+void render_sort_pool_shutdown() {
+	render_sort_pool_t *pool = &local.sort_pool;
+	if (pool->thread_count == 0) return;
+
+	ft_mutex_lock(pool->mtx);
+	pool->quit = true;
+	ft_condition_broadcast(pool->work_ready);
+	ft_mutex_unlock(pool->mtx);
+
+	// The threads touch the pool right up until they exit, so wait for them
+	// before tearing it down.
+	while (true) {
+		ft_mutex_lock(pool->mtx);
+		int32_t running = pool->thread_running;
+		ft_mutex_unlock(pool->mtx);
+		if (running == 0) break;
+		ft_yield();
 	}
+
+	ft_condition_destroy(&pool->work_ready);
+	ft_condition_destroy(&pool->work_done);
+	ft_mutex_destroy    (&pool->mtx);
+	sk_free(pool->work);
+	*pool = {};
+}
+
+///////////////////////////////////////////
+
+void render_sort_pool_dispatch(radix_job_fn job, void *job_ctx, int32_t job_count) {
+	render_sort_pool_t *pool = &local.sort_pool;
+
+	ft_mutex_lock(pool->mtx);
+	pool->job          = job;
+	pool->job_ctx      = job_ctx;
+	pool->job_count    = job_count;
+	pool->job_next     = 0;
+	pool->job_finished = 0;
+	ft_condition_broadcast(pool->work_ready);
+
+	// This thread pitches in too, rather than just sitting on the condition.
+	while (pool->job_next < pool->job_count) {
+		int32_t job_idx = pool->job_next++;
+		ft_mutex_unlock(pool->mtx);
+		job(job_ctx, job_idx);
+		ft_mutex_lock(pool->mtx);
+		pool->job_finished++;
+	}
+	while (pool->job_finished < pool->job_count)
+		ft_condition_wait(pool->work_done, pool->mtx);
+
+	// Nothing left for the threads to pick up until the next dispatch.
+	pool->job_count = 0;
+	pool->job_next  = 0;
+	ft_mutex_unlock(pool->mtx);
 }
 
 } // namespace sk
@@ -5,12 +5,19 @@
 
 namespace sk {
 
+const int32_t render_stats_lod_max = 8; // Matches render_frame_stats_t::lod_draws
+
 struct render_stats_t {
 	int swaps_mesh;
 	int swaps_texture;
 	int swaps_material;
 	int draw_calls;
 	int draw_instances;
+	int culled;
+	int occluded;
+	int instance_ring_size;
+	int instance_ring_stalls;
+	int lod_draws[render_stats_lod_max]; // Model visuals drawn at each LOD, the last one also counts anything past it
 };
 
 enum render_list_state_ {
@@ -21,8 +28,6 @@ enum render_list_state_ {
 	render_list_state_rendering,
 };
 
-typedef int32_t render_list_t;
-
 matrix        render_get_projection_matrix();
 float         render_get_ortho_view_height();
 matrix        render_get_cam_final        ();
@@ -30,6 +35,7 @@ matrix        render_get_cam_final_inv    ();
 color128      render_get_clear_color_ln   ();
 vec2          render_get_clip             ();
 void          render_draw_matrix          (const matrix *views, const matrix *projs, int32_t view_count, render_layer_ render_filter);
+void          render_draw_offscreen       ();
 void          render_clear                ();
 vec3          render_unproject_pt         (vec3 normalized_screen_pt);
 void          render_update_projection    ();
@@ -43,12 +49,7 @@ bool          render_init                 ();
 void          render_step                 ();
 void          render_shutdown             ();
 
-render_list_t render_list_create          ();
-void          render_list_release         (render_list_t list);
-void          render_list_push            (render_list_t list);
-void          render_list_pop             ();
 void          render_list_execute         (render_list_t list, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end);
 void          render_list_execute_material(render_list_t list, render_layer_ filter, uint32_t view_count, int32_t queue_start, int32_t queue_end, material_t override_material);
-void          render_list_clear           (render_list_t list);
 
 } // namespace sk
\ No newline at end of file
@@ -0,0 +1,217 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <float.h>
+#include <math.h>
+
+#ifndef _MSC_VER
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunknown-pragmas"
+#endif
+#include <DirectXMath.h>
+#ifndef _MSC_VER
+#pragma clang diagnostic pop
+#endif
+
+namespace sk {
+
+///////////////////////////////////////////
+// Software occlusion culling            //
+///////////////////////////////////////////
+
+// A small CPU side depth buffer that occluder meshes get rasterized into,
+// four pixels at a time. Render items can then be tested against it, and
+// anything whose bounds are entirely behind the occluders can be skipped
+// before it ever reaches the GPU.
+//
+// This is conservative in the direction of drawing too much: occluder
+// triangles are written at their farthest depth, triangles that cross the
+// near plane are left out, and an item's bounds are tested at their
+// nearest depth over every pixel they touch. Depth only needs to grow
+// further from the viewer, so this works with either clip space depth
+// convention.
+//
+// The caller owns the depth memory, which needs width*height floats, and
+// width must be a multiple of 4.
+
+struct occlusion_buffer_t {
+	float             *depth;
+	int32_t            width;
+	int32_t            height;
+	DirectX::XMMATRIX  viewproj;
+	int32_t            triangles;
+};
+
+///////////////////////////////////////////
+
+inline void occlusion_begin(occlusion_buffer_t *buffer, float *depth, int32_t width, int32_t height, const DirectX::XMMATRIX &viewproj) {
+	buffer->depth     = depth;
+	buffer->width     = width;
+	buffer->height    = height;
+	buffer->viewproj  = viewproj;
+	buffer->triangles = 0;
+
+	DirectX::XMVECTOR empty = DirectX::XMVectorReplicate(FLT_MAX);
+	for (int32_t i = 0; i < width * height; i += 4) {
+		DirectX::XMStoreFloat4((DirectX::XMFLOAT4*)&depth[i], empty);
+	}
+}
+
+///////////////////////////////////////////
+
+// Clip space to buffer pixels, x right and y down, z left as depth.
+inline DirectX::XMVECTOR occlusion_to_screen(const occlusion_buffer_t *buffer, DirectX::XMVECTOR clip) {
+	using namespace DirectX;
+	XMVECTOR ndc = XMVectorDivide(clip, XMVectorSplatW(clip));
+	XMVECTOR scale  = XMVectorSet( 0.5f * buffer->width, -0.5f * buffer->height, 1, 1);
+	XMVECTOR offset = XMVectorSet( 0.5f * buffer->width,  0.5f * buffer->height, 0, 0);
+	return XMVectorMultiplyAdd(ndc, scale, offset);
+}
+
+///////////////////////////////////////////
+
+inline void occlusion_rasterize_tri(occlusion_buffer_t *buffer, DirectX::XMVECTOR a, DirectX::XMVECTOR b, DirectX::XMVECTOR c) {
+	using namespace DirectX;
+
+	float ax = XMVectorGetX(a), ay = XMVectorGetY(a);
+	float bx = XMVectorGetX(b), by = XMVectorGetY(b);
+	float cx = XMVectorGetX(c), cy = XMVectorGetY(c);
+
+	// Winding doesn't matter for an occluder, so flip anything clockwise
+	// around and drop anything with no area.
+	float area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+	if (area == 0) return;
+	if (area < 0) {
+		float tx = bx, ty = by;
+		bx = cx; by = cy;
+		cx = tx; cy = ty;
+	}
+
+	int32_t min_x = (int32_t)floorf(fminf(ax, fminf(bx, cx)));
+	int32_t max_x = (int32_t)ceilf (fmaxf(ax, fmaxf(bx, cx)));
+	int32_t min_y = (int32_t)floorf(fminf(ay, fminf(by, cy)));
+	int32_t max_y = (int32_t)ceilf (fmaxf(ay, fmaxf(by, cy)));
+	if (min_x < 0) min_x = 0;
+	if (min_y < 0) min_y = 0;
+	if (max_x > buffer->width  - 1) max_x = buffer->width  - 1;
+	if (max_y > buffer->height - 1) max_y = buffer->height - 1;
+	if (min_x > max_x || min_y > max_y) return;
+	min_x &= ~3;
+
+	// Edge functions in the form e = x*A + y*B + C, positive inside. These
+	// get evaluated at pixel centers, but C is biased by half a pixel
+	// along each edge's normal, which moves the test to the pixel corner
+	// furthest inside the edge. A pixel is only written when the triangle
+	// covers all of it, since occlusion_visible treats any pixel its
+	// bounds touch as fully behind the stored depth.
+	XMVECTOR edge_a[3], edge_b[3], edge_c[3];
+	const float px[3] = { ax, bx, cx };
+	const float py[3] = { ay, by, cy };
+	for (int32_t e = 0; e < 3; e++) {
+		int32_t n = (e + 1) % 3;
+		float   A = py[e] - py[n];
+		float   B = px[n] - px[e];
+		edge_a[e] = XMVectorReplicate(A);
+		edge_b[e] = XMVectorReplicate(B);
+		edge_c[e] = XMVectorReplicate(-(A * px[e] + B * py[e]) - 0.5f * (fabsf(A) + fabsf(B)));
+	}
+
+	XMVECTOR depth = XMVectorReplicate(fmaxf(XMVectorGetZ(a), fmaxf(XMVectorGetZ(b), XMVectorGetZ(c))));
+	XMVECTOR zero  = XMVectorZero();
+	XMVECTOR step  = XMVectorSet(0.5f, 1.5f, 2.5f, 3.5f);
+	for (int32_t y = min_y; y <= max_y; y++) {
+		XMVECTOR fy  = XMVectorReplicate((float)y + 0.5f);
+		float   *row = &buffer->depth[y * buffer->width];
+		for (int32_t x = min_x; x <= max_x; x += 4) {
+			XMVECTOR fx     = XMVectorAdd(XMVectorReplicate((float)x), step);
+			XMVECTOR inside = XMVectorTrueInt();
+			for (int32_t e = 0; e < 3; e++) {
+				XMVECTOR value = XMVectorMultiplyAdd(fx, edge_a[e], XMVectorMultiplyAdd(fy, edge_b[e], edge_c[e]));
+				inside = XMVectorAndInt(inside, XMVectorGreaterOrEqual(value, zero));
+			}
+			XMVECTOR curr = XMLoadFloat4((XMFLOAT4*)&row[x]);
+			XMStoreFloat4((XMFLOAT4*)&row[x], XMVectorSelect(curr, XMVectorMin(curr, depth), inside));
+		}
+	}
+	buffer->triangles++;
+}
+
+///////////////////////////////////////////
+
+// Positions are read as 3 floats from the start of each vertex, so vert_t
+// and plain vec3 arrays both work.
+inline void occlusion_rasterize(occlusion_buffer_t *buffer, const void *verts, size_t vert_stride, uint32_t vert_count, const uint32_t *inds, uint32_t ind_count, const DirectX::XMMATRIX &world) {
+	using namespace DirectX;
+	XMMATRIX mvp = world * buffer->viewproj;
+
+	for (uint32_t i = 0; i + 2 < ind_count; i += 3) {
+		XMVECTOR clip[3];
+		bool     valid = true;
+		for (int32_t v = 0; v < 3; v++) {
+			uint32_t idx = inds[i + v];
+			if (idx >= vert_count) { valid = false; break; }
+			XMVECTOR pos = XMLoadFloat3((const XMFLOAT3*)((const uint8_t*)verts + idx * vert_stride));
+			clip[v] = XMVector4Transform(XMVectorSetW(pos, 1), mvp);
+			// Anything reaching the near plane would need clipping, and
+			// leaving it out only means occluding a little less.
+			if (XMVectorGetW(clip[v]) <= 0.0001f) { valid = false; break; }
+		}
+		if (!valid) continue;
+
+		occlusion_rasterize_tri(buffer,
+			occlusion_to_screen(buffer, clip[0]),
+			occlusion_to_screen(buffer, clip[1]),
+			occlusion_to_screen(buffer, clip[2]));
+	}
+}
+
+///////////////////////////////////////////
+
+// Bounds are a world space AABB, true means some part of it may be visible.
+inline bool occlusion_visible(const occlusion_buffer_t *buffer, DirectX::XMVECTOR center, DirectX::XMVECTOR extents) {
+	using namespace DirectX;
+	if (buffer->triangles == 0) return true;
+
+	XMVECTOR min_pt = XMVectorReplicate( FLT_MAX);
+	XMVECTOR max_pt = XMVectorReplicate(-FLT_MAX);
+	for (int32_t i = 0; i < 8; i++) {
+		XMVECTOR sign   = XMVectorSet(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 0);
+		XMVECTOR corner = XMVectorMultiplyAdd(extents, sign, center);
+		XMVECTOR clip   = XMVector4Transform(XMVectorSetW(corner, 1), buffer->viewproj);
+		// Bounds that reach behind the viewer can't be projected, the
+		// viewer may well be inside them.
+		if (XMVectorGetW(clip) <= 0.0001f) return true;
+
+		XMVECTOR screen = occlusion_to_screen(buffer, clip);
+		min_pt = XMVectorMin(min_pt, screen);
+		max_pt = XMVectorMax(max_pt, screen);
+	}
+
+	int32_t min_x = (int32_t)floorf(XMVectorGetX(min_pt));
+	int32_t max_x = (int32_t)ceilf (XMVectorGetX(max_pt));
+	int32_t min_y = (int32_t)floorf(XMVectorGetY(min_pt));
+	int32_t max_y = (int32_t)ceilf (XMVectorGetY(max_pt));
+	if (min_x < 0) min_x = 0;
+	if (min_y < 0) min_y = 0;
+	if (max_x > buffer->width  - 1) max_x = buffer->width  - 1;
+	if (max_y > buffer->height - 1) max_y = buffer->height - 1;
+	// Off screen is frustum culling's job, not ours
+	if (min_x > max_x || min_y > max_y) return true;
+	// Rounding out to whole groups of 4 only ever tests extra pixels
+	min_x &= ~3;
+
+	// Visible as soon as any pixel has nothing in front of the bounds'
+	// nearest point.
+	XMVECTOR nearest = XMVectorSplatZ(min_pt);
+	for (int32_t y = min_y; y <= max_y; y++) {
+		const float *row = &buffer->depth[y * buffer->width];
+		for (int32_t x = min_x; x <= max_x; x += 4) {
+			XMVECTOR occluder = XMLoadFloat4((const XMFLOAT4*)&row[x]);
+			if (!XMVector4Less(occluder, nearest)) return true;
+		}
+	}
+	return false;
+}
+
+} // namespace sk
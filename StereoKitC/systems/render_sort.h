@@ -0,0 +1,286 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <assert.h>
+
+#if _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace sk {
+
+///////////////////////////////////////////
+// Radix render sorting!                 //
+///////////////////////////////////////////
+
+// https://travisdowns.github.io/blog/2019/05/22/sorting.html
+
+// This sorts anything with a uint64_t sort_id member, and needs a scratch
+// area at least as large as the data being sorted. The render queue sorts
+// small key/index pairs with it, rather than whole render items.
+
+const size_t   RADIX_BITS   = 8;
+const size_t   RADIX_SIZE   = (size_t)1 << RADIX_BITS;
+const size_t   RADIX_LEVELS = (63 / RADIX_BITS) + 1;
+const uint64_t RADIX_MASK   = RADIX_SIZE - 1;
+
+using freq_array_type = size_t [RADIX_LEVELS][RADIX_SIZE];
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_count_frequency(const T *a, size_t count, freq_array_type freqs) {
+	for (size_t i = 0; i < count; i++) {
+		uint64_t value = a[i].sort_id;
+		for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
+			freqs[pass][value & RADIX_MASK]++;
+			value >>= RADIX_BITS;
+		}
+	}
+}
+
+///////////////////////////////////////////
+
+/**
+* Determine if the frequencies for a given level are "trivial".
+*
+* Frequencies are trivial if only a single frequency has non-zero
+* occurrences. In that case, the radix step just acts as a copy so we can
+* skip it.
+*/
+inline bool radix_is_trivial(const size_t freqs[RADIX_SIZE], size_t count) {
+	for (size_t i = 0; i < RADIX_SIZE; i++) {
+		size_t freq = freqs[i];
+		if (freq != 0) {
+			return freq == count;
+		}
+	}
+	assert(count == 0); // we only get here if count was zero
+	return true;
+}
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_sort7(T *a, T *scratch, size_t count) {
+	freq_array_type freqs = {};
+	radix_count_frequency(a, count, freqs);
+
+	T *from = a, *to = scratch;
+
+	for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
+
+		if (radix_is_trivial(freqs[pass], count)) {
+			// this pass would do nothing, just skip it
+			continue;
+		}
+
+		uint64_t shift = pass * RADIX_BITS;
+
+		// array of pointers to the current position in each queue, which we set up based on the
+		// known final sizes of each queue (i.e., "tighly packed")
+		T *queue_ptrs[RADIX_SIZE], *next = to;
+		for (size_t i = 0; i < RADIX_SIZE; i++) {
+			queue_ptrs[i] = next;
+			next += freqs[pass][i];
+		}
+
+		// copy each element into the appropriate queue based on the current RADIX_BITS sized
+		// "digit" within it
+		for (size_t i = 0; i < count; i++) {
+			T      value = from[i];
+			size_t index = (value.sort_id >> shift) & RADIX_MASK;
+			*queue_ptrs[index]++ = value;
+#ifdef _MSC_VER
+	#if defined(_M_ARM) || defined(_M_ARM64)
+			__prefetch (queue_ptrs[index] + 1);
+	#else
+			_m_prefetch(queue_ptrs[index] + 1);
+	#endif
+#else
+			__builtin_prefetch(queue_ptrs[index] + 1);
+#endif
+		}
+
+		// swap from and to areas
+		T *tmp = to;
+		to   = from;
+		from = tmp;
+	}
+
+	// because of the last swap, the "from" area has the sorted payload: if it's
+	// not the original array "a", do a final copy
+	if (from != a) {
+		memcpy(a, from, count*sizeof(T));
+	}
+}
+
+///////////////////////////////////////////
+// Multi-threaded radix sort             //
+///////////////////////////////////////////
+
+// Same sort as radix_sort7, but the counting and scatter passes are split
+// into contiguous chunks, one per job. Each job keeps its own histogram, and
+// a prefix sum over (digit, job) gives every job its own write offsets, so
+// the result is identical to the single threaded sort. The caller provides
+// the dispatch function, which must run job(ctx, i) for every i in
+// [0, job_count) and return only once they've all finished.
+
+const int32_t RADIX_MT_MAX_JOBS = 16;
+
+typedef void (*radix_job_fn     )(void *job_ctx, int32_t job_idx);
+typedef void (*radix_dispatch_fn)(radix_job_fn job, void *job_ctx, int32_t job_count);
+
+// Per-job histograms, large enough that it shouldn't live on the stack.
+struct radix_mt_work_t {
+	freq_array_type freqs[RADIX_MT_MAX_JOBS];
+};
+
+template <typename T>
+struct radix_mt_ctx_t {
+	T               *from;
+	T               *to;
+	size_t           count;
+	int32_t          job_count;
+	size_t           pass;
+	radix_mt_work_t *work;
+};
+
+///////////////////////////////////////////
+
+inline void radix_mt_job_range(size_t count, int32_t job_count, int32_t job_idx, size_t *out_start, size_t *out_end) {
+	*out_start = (count *  job_idx     ) / job_count;
+	*out_end   = (count * (job_idx + 1)) / job_count;
+}
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_mt_count_all(void *job_ctx, int32_t job_idx) {
+	radix_mt_ctx_t<T> *ctx = (radix_mt_ctx_t<T> *)job_ctx;
+	size_t start, end;
+	radix_mt_job_range(ctx->count, ctx->job_count, job_idx, &start, &end);
+
+	memset(ctx->work->freqs[job_idx], 0, sizeof(freq_array_type));
+	radix_count_frequency(ctx->from + start, end - start, ctx->work->freqs[job_idx]);
+}
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_mt_count_pass(void *job_ctx, int32_t job_idx) {
+	radix_mt_ctx_t<T> *ctx = (radix_mt_ctx_t<T> *)job_ctx;
+	size_t start, end;
+	radix_mt_job_range(ctx->count, ctx->job_count, job_idx, &start, &end);
+
+	size_t  *freqs = ctx->work->freqs[job_idx][ctx->pass];
+	uint64_t shift = ctx->pass * RADIX_BITS;
+	memset(freqs, 0, sizeof(size_t) * RADIX_SIZE);
+	for (size_t i = start; i < end; i++) {
+		freqs[(ctx->from[i].sort_id >> shift) & RADIX_MASK]++;
+	}
+}
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_mt_scatter(void *job_ctx, int32_t job_idx) {
+	radix_mt_ctx_t<T> *ctx = (radix_mt_ctx_t<T> *)job_ctx;
+	size_t start, end;
+	radix_mt_job_range(ctx->count, ctx->job_count, job_idx, &start, &end);
+
+	// By now the histogram holds this job's write offset for each digit
+	const size_t *offsets = ctx->work->freqs[job_idx][ctx->pass];
+	uint64_t      shift   = ctx->pass * RADIX_BITS;
+	T            *queue_ptrs[RADIX_SIZE];
+	for (size_t i = 0; i < RADIX_SIZE; i++) {
+		queue_ptrs[i] = ctx->to + offsets[i];
+	}
+
+	for (size_t i = start; i < end; i++) {
+		T      value = ctx->from[i];
+		size_t index = (value.sort_id >> shift) & RADIX_MASK;
+		*queue_ptrs[index]++ = value;
+#ifdef _MSC_VER
+	#if defined(_M_ARM) || defined(_M_ARM64)
+		__prefetch (queue_ptrs[index] + 1);
+	#else
+		_m_prefetch(queue_ptrs[index] + 1);
+	#endif
+#else
+		__builtin_prefetch(queue_ptrs[index] + 1);
+#endif
+	}
+}
+
+///////////////////////////////////////////
+
+template <typename T>
+void radix_sort7_mt(T *a, T *scratch, size_t count, radix_mt_work_t *work, int32_t job_count, radix_dispatch_fn dispatch) {
+	if (job_count > RADIX_MT_MAX_JOBS) job_count = RADIX_MT_MAX_JOBS;
+	if (job_count <= 1 || dispatch == nullptr || count < (size_t)job_count * RADIX_SIZE) {
+		radix_sort7(a, scratch, count);
+		return;
+	}
+
+	radix_mt_ctx_t<T> ctx = {};
+	ctx.from      = a;
+	ctx.to        = scratch;
+	ctx.count     = count;
+	ctx.job_count = job_count;
+	ctx.work      = work;
+
+	// Count every level at once, the totals tell us which passes we can skip,
+	// and the per-job counts are good for the first pass that isn't skipped.
+	dispatch(radix_mt_count_all<T>, &ctx, job_count);
+	freq_array_type totals = {};
+	for (int32_t j = 0; j < job_count; j++) {
+		for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
+			for (size_t i = 0; i < RADIX_SIZE; i++) {
+				totals[pass][i] += work->freqs[j][pass][i];
+			}
+		}
+	}
+
+	T   *from         = a, *to = scratch;
+	bool counts_fresh = true;
+	for (size_t pass = 0; pass < RADIX_LEVELS; pass++) {
+		if (radix_is_trivial(totals[pass], count))
+			continue;
+
+		ctx.from = from;
+		ctx.to   = to;
+		ctx.pass = pass;
+
+		// Once data has moved, each job's chunk holds different items than
+		// it did during the first count, so this level needs a recount.
+		if (!counts_fresh)
+			dispatch(radix_mt_count_pass<T>, &ctx, job_count);
+		counts_fresh = false;
+
+		// Digit major, job minor prefix sum: all of job 0's items for a digit
+		// go before job 1's, which keeps the sort stable.
+		size_t next = 0;
+		for (size_t i = 0; i < RADIX_SIZE; i++) {
+			for (int32_t j = 0; j < job_count; j++) {
+				size_t freq = work->freqs[j][pass][i];
+				work->freqs[j][pass][i] = next;
+				next += freq;
+			}
+		}
+
+		dispatch(radix_mt_scatter<T>, &ctx, job_count);
+
+		T *tmp = to;
+		to   = from;
+		from = tmp;
+	}
+
+	if (from != a) {
+		memcpy(a, from, count*sizeof(T));
+	}
+}
+
+} // namespace sk
@@ -67,6 +67,42 @@ system_t *systems_find(const char *name) {
 
 ///////////////////////////////////////////
 
+int32_t sk_profile_system_count() {
+	return systems.count;
+}
+
+///////////////////////////////////////////
+
+const char *sk_profile_system_name(int32_t system_index) {
+	if (system_index < 0 || system_index >= systems.count) return nullptr;
+	return systems[system_index].name;
+}
+
+///////////////////////////////////////////
+
+double sk_profile_system_total_ms(int32_t system_index) {
+	if (system_index < 0 || system_index >= systems.count) return 0;
+	return stm_ms(systems[system_index].profile_step_duration);
+}
+
+///////////////////////////////////////////
+
+uint64_t sk_profile_system_steps(int32_t system_index) {
+	if (system_index < 0 || system_index >= systems.count) return 0;
+	return systems[system_index].profile_step_count;
+}
+
+///////////////////////////////////////////
+
+uint64_t systems_step_duration() {
+	uint64_t result = 0;
+	for (int32_t i = 0; i < systems.count; i++)
+		result += systems[i].profile_step_duration;
+	return result;
+}
+
+///////////////////////////////////////////
+
 bool systems_sort() {
 	
 	int32_t result = 0;
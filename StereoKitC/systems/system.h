@@ -36,5 +36,6 @@ void      systems_step_partial(system_run_ run_section, int32_t system_idx);
 void      systems_shutdown    ();
 system_t* systems_find        (const char *name);
 int32_t   systems_find_idx    (const char *name);
+uint64_t  systems_step_duration();
 
 } // namespace sk
\ No newline at end of file
@@ -67,8 +67,9 @@ array_t<color128>     skui_tint_stack;
 
 ///////////////////////////////////////////
 
-void ui_default_mesh     (mesh_t* mesh, bool quadrantify, float diameter, float rounding, int32_t quadrant_slices);
-void ui_default_mesh_half(mesh_t* mesh, bool quadrantify, float diameter, float rounding, int32_t quadrant_slices, float angle_start);
+void ui_default_mesh       (mesh_t* mesh, bool quadrantify, float diameter, float rounding, int32_t quadrant_slices);
+void ui_default_mesh_half  (mesh_t* mesh, bool quadrantify, float diameter, float rounding, int32_t quadrant_slices, float angle_start);
+void ui_quadrant_set_bounds(mesh_t mesh);
 
 ///////////////////////////////////////////
 
@@ -517,12 +518,23 @@ void ui_quadrant_size_verts(vert_t *verts, int32_t count, float overflow) {
 
 ///////////////////////////////////////////
 
+void ui_quadrant_set_bounds(mesh_t mesh) {
+	// Quadrant verts are offsets from the edges of a unit quad that the
+	// shader stretches to fit the transform's scale, so their calculated
+	// bounds don't represent what actually gets drawn. The unit cube does,
+	// and keeps these meshes from getting incorrectly frustum culled.
+	mesh_set_bounds(mesh, bounds_t{ vec3_zero, vec3_one });
+}
+
+///////////////////////////////////////////
+
 void ui_quadrant_size_mesh(mesh_t ref_mesh, float overflow) {
 	vert_t *verts      = nullptr;
 	int32_t vert_count = 0;
 	mesh_get_verts        (ref_mesh, verts, vert_count, memory_reference);
 	ui_quadrant_size_verts(verts, vert_count, overflow);
 	mesh_set_verts        (ref_mesh, verts, vert_count);
+	ui_quadrant_set_bounds(ref_mesh);
 }
 
 ///////////////////////////////////////////
@@ -594,6 +606,8 @@ void ui_default_mesh(mesh_t *mesh, bool quadrantify, float diameter, float round
 		ui_quadrant_size_verts(verts, vert_count, 0);
 
 	mesh_set_data(*mesh, verts, vert_count, inds, ind_count);
+	if (quadrantify)
+		ui_quadrant_set_bounds(*mesh);
 
 	sk_free(verts);
 	sk_free(inds);
@@ -706,6 +720,8 @@ void ui_default_mesh_half(mesh_t *mesh, bool quadrantify, float diameter, float
 		ui_quadrant_size_verts(verts, vert_count, 0);
 
 	mesh_set_data(*mesh, verts, vert_count, inds, ind_count);
+	if (quadrantify)
+		ui_quadrant_set_bounds(*mesh);
 
 	sk_free(verts);
 	sk_free(inds);